@@ -0,0 +1,92 @@
+#include <malloc.h>
+
+#include <utility>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+// Heap in use, including stacks which are allocated with mmap
+size_t heapInUse()
+{
+    const struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+}
+
+// Suspends coroutineCount coroutines on a single timer and reports memory
+// held while they are suspended. Frames carry no discovery state, so this
+// is the per coroutine overhead only. Memory of the real discovery flows
+// is reported by rss_growth_kB of bench-discovery_scale.
+template <typename Spawn>
+void runSuspended(benchmark::State& state, Spawn&& spawn)
+{
+    const auto coroutineCount = static_cast<size_t>(state.range(0));
+    double bytesPerCoroutine = 0;
+
+    for (auto _ : state)
+    {
+        boost::asio::io_context ioc;
+        boost::asio::steady_timer response(
+            ioc, boost::asio::steady_timer::time_point::max());
+
+        const size_t heapBefore = heapInUse();
+        for (size_t i = 0; i < coroutineCount; i++)
+        {
+            spawn(ioc, response);
+        }
+        ioc.poll();
+        bytesPerCoroutine +=
+            static_cast<double>(heapInUse() - heapBefore) /
+            static_cast<double>(coroutineCount);
+
+        response.cancel();
+        ioc.run();
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<int64_t>(coroutineCount));
+    state.counters["bytes/coroutine"] = benchmark::Counter(
+        bytesPerCoroutine, benchmark::Counter::kAvgIterations);
+}
+
+void BM_StackfulCoroutines(benchmark::State& state)
+{
+    runSuspended(state, [](boost::asio::io_context& ioc,
+                           boost::asio::steady_timer& response) {
+        boost::asio::spawn(ioc,
+                           [&response](boost::asio::yield_context yield) {
+                               boost::system::error_code ec;
+                               response.async_wait(yield[ec]);
+                           });
+    });
+}
+
+void BM_StacklessCoroutines(benchmark::State& state)
+{
+    runSuspended(state, [](boost::asio::io_context& ioc,
+                           boost::asio::steady_timer& response) {
+        boost::asio::co_spawn(
+            ioc,
+            [&response]() -> boost::asio::awaitable<void> {
+                boost::system::error_code ec;
+                co_await response.async_wait(boost::asio::redirect_error(
+                    boost::asio::use_awaitable, ec));
+            },
+            boost::asio::detached);
+    });
+}
+
+} // namespace
+
+BENCHMARK(BM_StackfulCoroutines)->Arg(16)->Arg(256);
+BENCHMARK(BM_StacklessCoroutines)->Arg(16)->Arg(256);
@@ -0,0 +1,168 @@
+#include "mctp_cmd_encoder.hpp"
+#include "utils/binding_private.hpp"
+
+#include "libmctp-msgtypes.h"
+
+#include <cstdlib>
+#include <new>
+#include <span>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+/*
+ * Models formatting of a control request and the copy kept for its
+ * retransmissions only. Transaction table, deadline, correlator, response
+ * and callback allocations of the real control queue are not covered here,
+ * bench-ctrl_tx_queue counts those through MCTPDevice.
+ */
+
+// Counted by replaceable global operator new below, for the whole binary
+size_t allocations = 0;
+
+constexpr uint8_t discoveredEid = 10;
+constexpr size_t bindingPrivateSize = 8;
+
+// Stands for mctp_message_tx, which takes request and private data pointers
+__attribute__((noinline)) void transmit(void* msg, size_t len, void* pvt)
+{
+    benchmark::DoNotOptimize(msg);
+    benchmark::DoNotOptimize(len);
+    benchmark::DoNotOptimize(pvt);
+}
+
+/*
+ * Control path before compile time encoder. Request is formatted into a
+ * resized vector, copied into control queue with binding private data, and
+ * both are copied again by value on every transmission.
+ */
+struct LegacyTransaction
+{
+    std::vector<uint8_t> bindingPrivate;
+    std::vector<uint8_t> req;
+};
+
+void legacySend(std::vector<uint8_t> req, std::vector<uint8_t> bindingPrivate)
+{
+    transmit(req.data(), req.size(), bindingPrivate.data());
+}
+
+template <typename Cmd, typename Encode, typename... Args>
+void legacyRequest(const std::vector<uint8_t>& bindingPrivate,
+                   unsigned retransmissions, Encode encode, Args... args)
+{
+    std::vector<uint8_t> req;
+    req.resize(sizeof(Cmd));
+    encode(reinterpret_cast<Cmd*>(req.data()), getRqDgramInst(), args...);
+
+    LegacyTransaction transaction{bindingPrivate, req};
+    for (unsigned i = 0; i <= retransmissions; i++)
+    {
+        legacySend(transaction.req, transaction.bindingPrivate);
+    }
+    benchmark::DoNotOptimize(transaction);
+}
+
+// Request and binding private data are both stored inline
+struct Transaction
+{
+    mctpd::BindingPrivate bindingPrivate;
+    CtrlReqBuffer req;
+};
+
+template <int cmd, typename... Args>
+void request(const mctpd::BindingPrivate& bindingPrivate,
+             unsigned retransmissions, Args... args)
+{
+    const auto req = getFormattedReq<cmd>(args...).value();
+
+    Transaction transaction{bindingPrivate,
+                            CtrlReqBuffer(req.begin(), req.end())};
+    for (unsigned i = 0; i <= retransmissions; i++)
+    {
+        transmit(transaction.req.data(), transaction.req.size(),
+                 transaction.bindingPrivate.data());
+    }
+    benchmark::DoNotOptimize(transaction);
+}
+
+void reportAllocations(benchmark::State& state, size_t allocationsBefore)
+{
+    state.counters["allocs/endpoint"] =
+        benchmark::Counter(static_cast<double>(allocations - allocationsBefore),
+                           benchmark::Counter::kAvgIterations);
+}
+
+// Control requests bus owner sends to register a simple endpoint
+void BM_LegacyCtrlRequests(benchmark::State& state)
+{
+    const auto retransmissions = static_cast<unsigned>(state.range(0));
+    const std::vector<uint8_t> bindingPrivate(bindingPrivateSize);
+    const size_t allocationsBefore = allocations;
+
+    for (auto _ : state)
+    {
+        legacyRequest<mctp_ctrl_cmd_set_eid>(
+            bindingPrivate, retransmissions, mctp_encode_ctrl_cmd_set_eid,
+            set_eid, discoveredEid);
+        legacyRequest<mctp_ctrl_cmd_get_uuid>(bindingPrivate, retransmissions,
+                                              mctp_encode_ctrl_cmd_get_uuid);
+        legacyRequest<mctp_ctrl_cmd_get_msg_type_support>(
+            bindingPrivate, retransmissions,
+            mctp_encode_ctrl_cmd_get_msg_type_support);
+        legacyRequest<mctp_ctrl_cmd_get_mctp_ver_support>(
+            bindingPrivate, retransmissions,
+            mctp_encode_ctrl_cmd_get_ver_support,
+            uint8_t{MCTP_MESSAGE_TYPE_MCTP_CTRL});
+    }
+    reportAllocations(state, allocationsBefore);
+}
+BENCHMARK(BM_LegacyCtrlRequests)->Arg(0)->Arg(2);
+
+void BM_CtrlRequests(benchmark::State& state)
+{
+    const auto retransmissions = static_cast<unsigned>(state.range(0));
+    const mctpd::BindingPrivate bindingPrivate(bindingPrivateSize);
+    const size_t allocationsBefore = allocations;
+
+    for (auto _ : state)
+    {
+        request<MCTP_CTRL_CMD_SET_ENDPOINT_ID>(bindingPrivate, retransmissions,
+                                               set_eid, discoveredEid);
+        request<MCTP_CTRL_CMD_GET_ENDPOINT_UUID>(bindingPrivate,
+                                                 retransmissions);
+        request<MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT>(bindingPrivate,
+                                                        retransmissions);
+        request<MCTP_CTRL_CMD_GET_VERSION_SUPPORT>(
+            bindingPrivate, retransmissions,
+            uint8_t{MCTP_MESSAGE_TYPE_MCTP_CTRL});
+    }
+    reportAllocations(state, allocationsBefore);
+}
+BENCHMARK(BM_CtrlRequests)->Arg(0)->Arg(2);
+
+} // namespace
+
+// Not inlined, so that compiler does not pair free() with operator new
+__attribute__((noinline)) void* operator new(size_t size)
+{
+    ++allocations;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
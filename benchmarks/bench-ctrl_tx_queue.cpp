@@ -0,0 +1,180 @@
+#include "bindings/TestBinding.hpp"
+#include "mctp_cmd_encoder.hpp"
+#include "mocks/objectServerMock.hpp"
+
+#include <array>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <new>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+// Counted by replaceable global operator new below, for the whole binary.
+// libmctp packet buffers come from malloc and are not counted.
+size_t allocations = 0;
+
+constexpr mctp_eid_t destEid = 10;
+constexpr uint8_t respEid = 99;
+
+/*
+ * Test binding on top of fake driver, with transmit of the driver taken over
+ * so that neither the driver nor the responder allocates. Requests are kept
+ * in fixed array and answered with Get Endpoint ID response built straight
+ * in libmctp packet buffer. Every counted allocation is then made by
+ * MCTPDevice control path: pushToCtrlTxQueue, response handling and the
+ * completion handler.
+ */
+class CtrlTxFixture
+{
+  public:
+    static constexpr size_t maxInFlight = 8;
+
+    CtrlTxFixture()
+    {
+        bus = std::make_shared<mctpd_mock::object_server_mock>();
+        mctpInterface = bus->backdoor.add_interface(
+            "/xyz/openbmc_project/test_mctp", mctp_server::interface);
+        mctpInterface->returnByDefault(true);
+
+        Configuration config{};
+        config.reqRetryCount = 0;
+        config.reqToRespTime = 1000;
+        binding = std::make_shared<TestBinding>(
+            conn, bus, "/xyz/openbmc_project/test_mctp", config, ioc);
+        binding->initializeBinding();
+        binding->driver.txHandler = [this](mctp_binding*, mctp_pktbuf* pkt) {
+            return record(pkt);
+        };
+    }
+
+    // Sends count Get Endpoint ID requests, answers all of them and runs
+    // completion handlers
+    void transact(size_t count)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            binding->asyncSendAndRcvMctpCtrl(
+                req, destEid, {},
+                [this](boost::system::error_code ec, std::vector<uint8_t>) {
+                    completions += !ec;
+                });
+        }
+        for (size_t i = 0; i < sentCount; i++)
+        {
+            respond(sent[i]);
+        }
+        sentCount = 0;
+        ioc.poll();
+        ioc.restart();
+    }
+
+    size_t completions = 0;
+
+  private:
+    struct SentRequest
+    {
+        mctp_hdr header;
+        mctp_ctrl_msg_hdr ctrlHdr;
+    };
+
+    int record(mctp_pktbuf* pkt)
+    {
+        if (sentCount == maxInFlight)
+        {
+            return -1;
+        }
+        auto& request = sent[sentCount++];
+        request.header = *mctp_pktbuf_hdr(pkt);
+        std::memcpy(&request.ctrlHdr, mctp_pktbuf_data(pkt),
+                    sizeof(request.ctrlHdr));
+        return 0;
+    }
+
+    void respond(const SentRequest& request)
+    {
+        mctp_pktbuf* pkt = mctp_pktbuf_alloc(
+            &binding->driver.binding,
+            sizeof(mctp_ctrl_resp_get_eid) + sizeof(mctp_hdr));
+        auto hdr = mctp_pktbuf_hdr(pkt);
+        hdr->dest = request.header.src;
+        hdr->src = request.header.dest;
+        hdr->ver = request.header.ver;
+        hdr->flags_seq_tag = static_cast<uint8_t>(
+            MCTP_HDR_FLAG_SOM | MCTP_HDR_FLAG_EOM |
+            (request.header.flags_seq_tag & MCTP_HDR_TAG_MASK));
+
+        auto payload =
+            reinterpret_cast<mctp_ctrl_resp_get_eid*>(mctp_pktbuf_data(pkt));
+        std::memset(payload, 0, sizeof(*payload));
+        payload->ctrl_hdr = request.ctrlHdr;
+        payload->ctrl_hdr.rq_dgram_inst &=
+            static_cast<uint8_t>(~(MCTP_CTRL_HDR_FLAG_REQUEST));
+        payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+        payload->eid = respEid;
+        mctp_bus_rx(&binding->driver.binding, pkt);
+    }
+
+    const std::array<uint8_t, sizeof(mctp_ctrl_cmd_get_eid)> req =
+        getFormattedReq<MCTP_CTRL_CMD_GET_ENDPOINT_ID>().value();
+    std::array<SentRequest, maxInFlight> sent{};
+    size_t sentCount = 0;
+
+    boost::asio::io_context ioc;
+    std::shared_ptr<sdbusplus::asio::connection> conn;
+    std::shared_ptr<mctpd_mock::object_server_mock> bus;
+    std::shared_ptr<mctpd_mock::dbus_interface_mock> mctpInterface;
+    std::shared_ptr<TestBinding> binding;
+};
+
+// Control requests answered while given number of them is in flight
+void BM_CtrlTxQueue(benchmark::State& state)
+{
+    const auto inFlight = static_cast<size_t>(state.range(0));
+    CtrlTxFixture fixture;
+    // First round grows tables, allocation pools and handler caches
+    fixture.transact(inFlight);
+    fixture.completions = 0;
+
+    const size_t allocationsBefore = allocations;
+    for (auto _ : state)
+    {
+        fixture.transact(inFlight);
+    }
+    const auto requests = state.iterations() * static_cast<int64_t>(inFlight);
+    state.counters["allocs/request"] =
+        static_cast<double>(allocations - allocationsBefore) /
+        static_cast<double>(requests);
+    if (fixture.completions != static_cast<size_t>(requests))
+    {
+        state.SkipWithError("Control request did not complete");
+    }
+    state.SetItemsProcessed(requests);
+}
+BENCHMARK(BM_CtrlTxQueue)->Arg(1)->Arg(8);
+
+} // namespace
+
+// Not inlined, so that compiler does not pair free() with operator new
+__attribute__((noinline)) void* operator new(size_t size)
+{
+    ++allocations;
+    if (void* ptr = std::malloc(size == 0 ? 1 : size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
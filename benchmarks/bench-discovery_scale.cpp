@@ -0,0 +1,547 @@
+#include "bindings/smbus/TestSMBusBinding.hpp"
+#include "utils/DelayedResponder.hpp"
+#include "utils/pcie/PCIeDiscoveredTestBase.hpp"
+
+#include <malloc.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+// Discovery which did not register all endpoints by then is reported as error
+constexpr auto registrationDeadline = std::chrono::seconds{60};
+constexpr uint8_t firstEndpointEid = 0x0A;
+constexpr uint8_t lastEndpointEid = 0xFE;
+
+// Runs handlers until done returns true, false if deadline passed before
+template <typename Predicate>
+bool runUntil(boost::asio::io_context& ioc, Predicate&& done)
+{
+    const auto deadline =
+        std::chrono::steady_clock::now() + registrationDeadline;
+    while (!done())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        ioc.run_one_for(std::chrono::milliseconds{10});
+    }
+    return true;
+}
+
+// EIDs given to simulated endpoints, skipping ownEid of the binding
+std::vector<uint8_t> allocateEids(size_t count, uint8_t ownEid)
+{
+    std::vector<uint8_t> eids;
+    for (unsigned eid = firstEndpointEid;
+         eid <= lastEndpointEid && eids.size() < count; eid++)
+    {
+        if (eid != ownEid)
+        {
+            eids.push_back(static_cast<uint8_t>(eid));
+        }
+    }
+    return eids;
+}
+
+// Current RSS of the process in kB
+double residentKb()
+{
+    std::ifstream statm("/proc/self/statm");
+    size_t size = 0;
+    size_t resident = 0;
+    statm >> size >> resident;
+    return static_cast<double>(resident * sysconf(_SC_PAGESIZE)) / 1024;
+}
+
+/*
+ * RSS grown while fixture is alive. Peak RSS of the process cannot be used,
+ * it only reports the largest case run so far. Free heap is returned to the
+ * system first, so that memory released by previous cases is not reused
+ * unnoticed.
+ */
+class RssGrowth
+{
+  public:
+    RssGrowth()
+    {
+        malloc_trim(0);
+        baseline = residentKb();
+    }
+
+    double kb() const
+    {
+        return std::max(residentKb() - baseline, 0.0);
+    }
+
+  private:
+    double baseline;
+};
+
+void reportDiscovery(benchmark::State& state, size_t endpointCount,
+                     size_t ctrlRequests, double rssGrowthKb)
+{
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<int64_t>(endpointCount));
+    state.counters["ctrl_msgs"] =
+        benchmark::Counter(static_cast<double>(ctrlRequests),
+                           benchmark::Counter::kAvgIterations);
+    state.counters["rss_growth_kB"] = rssGrowthKb;
+}
+
+/*
+ * Discovered PCIe endpoint reading routing table of the bus owner. Bridges
+ * and endpoints connected directly are listed by the bus owner, endpoints
+ * behind bridges are spread evenly across them and listed by the bridge.
+ */
+class PCIeDiscoveryFixture : public PCIeDiscoveredTestBase
+{
+  public:
+    PCIeDiscoveryFixture(size_t endpointCount, size_t bridgeCount,
+                         std::chrono::microseconds latency) :
+        responder(ioc,
+                  std::static_pointer_cast<FakePCIeDriver>(binding->hw)->hw,
+                  latency, [this](const auto& request) { respond(request); })
+    {
+        eids = allocateEids(endpointCount + bridgeCount, assignedEid);
+
+        for (size_t i = 0; i < bridgeCount; i++)
+        {
+            tables[busOwnerEid].push_back(
+                {eids[i], static_cast<uint16_t>(firstBridgeBdf + (i << 8)),
+                 MCTP_ROUTING_ENTRY_BRIDGE << 4});
+        }
+        for (size_t i = bridgeCount; i < eids.size(); i++)
+        {
+            // Every bridge and the bus owner take endpoints in turns
+            const size_t owner = i % (bridgeCount + 1);
+            const uint8_t tableOwner =
+                owner == bridgeCount ? busOwnerEid : eids[owner];
+            tables[tableOwner].push_back(
+                {eids[i], static_cast<uint16_t>(firstEndpointBdf + i),
+                 MCTP_ROUTING_ENTRY_ENDPOINT});
+        }
+    }
+
+    // Runs until every endpoint is registered, returns time since routing
+    // table was first requested
+    std::optional<std::chrono::duration<double>> discover()
+    {
+        auto allRegistered = [this]() {
+            for (const uint8_t eid : eids)
+            {
+                if (binding->endpointInterface.count(eid) == 0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+        if (!runUntil(ioc, allRegistered) || !firstRoutingRequest)
+        {
+            return std::nullopt;
+        }
+        return std::chrono::steady_clock::now() - *firstRoutingRequest;
+    }
+
+    DelayedResponder responder;
+
+  private:
+    static constexpr uint8_t busOwnerEid = 0;
+    static constexpr uint16_t firstBridgeBdf = 0x0100;
+    static constexpr uint16_t firstEndpointBdf = 0x4000;
+
+    struct Entry
+    {
+        uint8_t eid;
+        uint16_t bdf;
+        uint8_t entryType;
+    };
+
+    std::vector<uint8_t> eids;
+    std::map<uint8_t, std::vector<Entry>> tables;
+    std::optional<std::chrono::steady_clock::time_point> firstRoutingRequest;
+
+    void respond(const mctp_binding_fake::mctp_frame& request)
+    {
+        auto hdr =
+            reinterpret_cast<const mctp_ctrl_msg_hdr*>(request.payload.data());
+        auto prv = *reinterpret_cast<const mctp_nupcie_pkt_private*>(
+            request.privateData.data());
+
+        if (hdr->command_code == MCTP_CTRL_CMD_GET_ROUTING_TABLE_ENTRIES)
+        {
+            respondRoutingTable(request, prv);
+        }
+        else if (hdr->command_code == MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT)
+        {
+            auto response = binding->backdoor.prepareCtrlResponse<
+                mctp_ctrl_resp_get_msg_type_support>(request, prv,
+                                                     sizeof(msg_type_entry));
+            response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+            response.payload->msg_type_count = 1;
+            *getTypeArray(response.payload) =
+                msg_type_entry{MCTP_MESSAGE_TYPE_PLDM};
+            binding->backdoor.rx(response);
+        }
+        else if (hdr->command_code == MCTP_CTRL_CMD_GET_ENDPOINT_UUID)
+        {
+            auto response = binding->backdoor
+                                .prepareCtrlResponse<mctp_ctrl_resp_get_uuid>(
+                                    request, prv);
+            response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+            reinterpret_cast<uint8_t*>(&response.payload->uuid)[0] =
+                request.header.dest;
+            binding->backdoor.rx(response);
+        }
+    }
+
+    void respondRoutingTable(const mctp_binding_fake::mctp_frame& request,
+                             const mctp_nupcie_pkt_private& prv)
+    {
+        if (!firstRoutingRequest)
+        {
+            firstRoutingRequest = std::chrono::steady_clock::now();
+        }
+
+        const auto& entries = tables[request.header.dest];
+        auto response = binding->backdoor.prepareCtrlResponse<
+            mctp_ctrl_resp_get_routing_table>(
+            request, prv,
+            sizeof(mctp_ctrl_resp_get_routing_table_entry) * entries.size());
+        response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+        response.payload->number_of_entries =
+            static_cast<uint8_t>(entries.size());
+        response.payload->next_entry_handle = 0xff;
+
+        mctp_ctrl_resp_get_routing_table_entry* tableEntry =
+            getEntryArray(response.payload);
+        for (const Entry& src : entries)
+        {
+            tableEntry->entry.eid_range_size = 1;
+            tableEntry->entry.starting_eid = src.eid;
+            tableEntry->entry.entry_type = src.entryType;
+            tableEntry->entry.phys_transport_binding_id = MCTP_BINDING_PCIE;
+            tableEntry->entry.phys_address_size = sizeof(tableEntry->bdf);
+            tableEntry->bdf = htobe16(src.bdf);
+            tableEntry++;
+        }
+        binding->backdoor.rx(response);
+    }
+};
+
+/*
+ * SMBus bus owner registering devices found on the bus. Devices are spread
+ * over root and mux port fds, first bridgeCount of them report themselves
+ * as bridges.
+ */
+class SMBusDiscoveryFixture : public AsyncTestBase
+{
+  public:
+    SMBusDiscoveryFixture(size_t endpointCount, size_t bridgeCount,
+                          std::chrono::microseconds latency,
+                          std::optional<bool> pipelined = std::nullopt)
+    {
+        bus = std::make_shared<mctpd_mock::object_server_mock>();
+
+        config.mediumId = mctp_server::MctpPhysicalMediumIdentifiers::Smbus;
+        config.mode = mctp_server::BindingModeTypes::BusOwner;
+        config.defaultEid = ownEid;
+        config.reqRetryCount = 0;
+        config.reqToRespTime =
+            std::chrono::milliseconds{executionTimeout}.count();
+        config.bus = "/dev/i2c-1";
+        config.arpMasterSupport = false;
+        config.bmcSlaveAddr = 0x08;
+        config.routingIntervalSec = 0;
+        config.scanInterval = 0;
+        for (const uint8_t eid : allocateEids(lastEndpointEid, ownEid))
+        {
+            config.eidPool.insert(eid);
+        }
+
+        binding = std::make_shared<TestSMBusBinding>(
+            conn, bus, "/xyz/openbmc_project/test_mctp", config, ioc);
+        binding->initializeBinding();
+        binding->pipelinedRegistration = pipelined;
+        responder.emplace(ioc, binding->driver, latency,
+                          [this](const auto& request) { respond(request); });
+
+        const size_t deviceCount = endpointCount + bridgeCount;
+        for (size_t i = 0; i < deviceCount; i++)
+        {
+            const int fd = firstFd + static_cast<int>(i / addressesPerFd);
+            const auto address =
+                static_cast<uint8_t>(firstAddress + i % addressesPerFd);
+            devices.emplace(fd, address);
+            simulated.emplace(
+                std::make_pair(fd, static_cast<uint8_t>(address << 1)),
+                              Device{i, i < bridgeCount, MCTP_EID_NULL});
+        }
+    }
+
+    // Registers all devices, returns time taken
+    std::optional<std::chrono::duration<double>> discover()
+    {
+        bool done = false;
+        const auto start = std::chrono::steady_clock::now();
+        schedule([&]() -> boost::asio::awaitable<void> {
+            co_await binding->registerDevices(devices);
+            done = true;
+        });
+        if (!runUntil(ioc, [&done]() { return done; }) ||
+            binding->endpointInterface.size() != devices.size())
+        {
+            return std::nullopt;
+        }
+        return std::chrono::steady_clock::now() - start;
+    }
+
+    std::optional<DelayedResponder> responder;
+
+  private:
+    static constexpr uint8_t ownEid = 8;
+    static constexpr int firstFd = 100;
+    static constexpr uint8_t firstAddress = 0x10;
+    static constexpr size_t addressesPerFd = 100;
+    // Bus owner and bridge endpoint type in Get EID response
+    static constexpr uint8_t bridgeEidType = 0x10;
+
+    struct Device
+    {
+        size_t index;
+        bool bridge;
+        mctp_eid_t eid;
+    };
+
+    SMBusConfiguration config{};
+    std::shared_ptr<TestSMBusBinding> binding;
+    std::shared_ptr<sdbusplus::asio::connection> conn;
+    std::shared_ptr<mctpd_mock::object_server_mock> bus;
+    std::set<std::pair<int, uint8_t>> devices;
+    std::map<std::pair<int, uint8_t>, Device> simulated;
+
+    void respond(const mctp_binding_fake::mctp_frame& request)
+    {
+        auto hdr =
+            reinterpret_cast<const mctp_ctrl_msg_hdr*>(request.payload.data());
+        auto prv = *reinterpret_cast<const mctp_smbus_pkt_private*>(
+            request.privateData.data());
+        auto& backdoor = binding->backdoor;
+        // Copied out of packed struct, reference to it cannot be taken
+        const int fd = prv.fd;
+        auto device = simulated.find(std::make_pair(fd, prv.slave_addr));
+        if (device == simulated.end())
+        {
+            return;
+        }
+
+        switch (hdr->command_code)
+        {
+            case MCTP_CTRL_CMD_GET_VERSION_SUPPORT: {
+                auto response = backdoor.prepareCtrlResponse<
+                    mctp_ctrl_resp_get_mctp_ver_support>(request, prv);
+                response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+                response.payload->number_of_entries = 1;
+                const uint8_t version[] = {0xF1, 0xF3, 0xF1, 0x00};
+                std::memcpy(&response.payload->version, version,
+                            sizeof(version));
+                backdoor.rx(response);
+                break;
+            }
+            case MCTP_CTRL_CMD_GET_ENDPOINT_ID: {
+                auto response =
+                    backdoor.prepareCtrlResponse<mctp_ctrl_resp_get_eid>(
+                        request, prv);
+                response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+                response.payload->eid = device->second.eid;
+                response.payload->eid_type =
+                    device->second.bridge ? bridgeEidType : 0;
+                backdoor.rx(response);
+                break;
+            }
+            case MCTP_CTRL_CMD_SET_ENDPOINT_ID: {
+                auto setEid = reinterpret_cast<const mctp_ctrl_cmd_set_eid*>(
+                    request.payload.data());
+                device->second.eid = setEid->eid;
+                auto response =
+                    backdoor.prepareCtrlResponse<mctp_ctrl_resp_set_eid>(
+                        request, prv);
+                response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+                response.payload->eid_set = setEid->eid;
+                backdoor.rx(response);
+                break;
+            }
+            case MCTP_CTRL_CMD_GET_ENDPOINT_UUID: {
+                auto response =
+                    backdoor.prepareCtrlResponse<mctp_ctrl_resp_get_uuid>(
+                        request, prv);
+                response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+                auto uuid = reinterpret_cast<uint8_t*>(&response.payload->uuid);
+                uuid[0] = static_cast<uint8_t>(device->second.index);
+                uuid[1] = static_cast<uint8_t>(device->second.index >> 8);
+                backdoor.rx(response);
+                break;
+            }
+            case MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT: {
+                auto response = backdoor.prepareCtrlResponse<
+                    mctp_ctrl_resp_get_msg_type_support>(
+                    request, prv, sizeof(msg_type_entry));
+                response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+                response.payload->msg_type_count = 1;
+                *MessageHelpers::getTypeArray(response.payload) =
+                    msg_type_entry{MCTP_MESSAGE_TYPE_PLDM};
+                backdoor.rx(response);
+                break;
+            }
+            case MCTP_CTRL_CMD_ROUTING_INFO_UPDATE: {
+                auto response = backdoor.prepareCtrlResponse<
+                    mctp_ctrl_resp_routing_info_update>(request, prv);
+                response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+                backdoor.rx(response);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+};
+
+/*
+ * Time from first request for routing table of the bus owner until every
+ * endpoint from routing tables is registered. Routing table is first read
+ * when getRoutingInterval passes after discovery, which is not measured.
+ */
+void BM_PCIeDiscoveryScale(benchmark::State& state)
+{
+    const auto endpointCount = static_cast<size_t>(state.range(0));
+    const auto bridgeCount = static_cast<size_t>(state.range(1));
+    const auto latency = std::chrono::microseconds{state.range(2)};
+
+    size_t ctrlRequests = 0;
+    double rssGrowthKb = 0;
+    for (auto _ : state)
+    {
+        RssGrowth rssGrowth;
+        PCIeDiscoveryFixture fixture(endpointCount, bridgeCount, latency);
+        auto elapsed = fixture.discover();
+        if (!elapsed)
+        {
+            state.SkipWithError("Endpoints were not registered in time");
+            break;
+        }
+        state.SetIterationTime(elapsed->count());
+        ctrlRequests += fixture.responder.ctrlRequests;
+        rssGrowthKb = std::max(rssGrowthKb, rssGrowth.kb());
+    }
+
+    reportDiscovery(state, endpointCount + bridgeCount, ctrlRequests,
+                    rssGrowthKb);
+}
+
+/*
+ * Time until registerDevices returns for devices found by bus scan, which
+ * is run one device after another.
+ */
+void BM_SMBusDiscoveryScale(benchmark::State& state)
+{
+    const auto endpointCount = static_cast<size_t>(state.range(0));
+    const auto bridgeCount = static_cast<size_t>(state.range(1));
+    const auto latency = std::chrono::microseconds{state.range(2)};
+
+    size_t ctrlRequests = 0;
+    double rssGrowthKb = 0;
+    for (auto _ : state)
+    {
+        RssGrowth rssGrowth;
+        SMBusDiscoveryFixture fixture(endpointCount, bridgeCount, latency);
+        auto elapsed = fixture.discover();
+        if (!elapsed)
+        {
+            state.SkipWithError("Devices were not registered in time");
+            break;
+        }
+        state.SetIterationTime(elapsed->count());
+        ctrlRequests += fixture.responder->ctrlRequests;
+        rssGrowthKb = std::max(rssGrowthKb, rssGrowth.kb());
+    }
+
+    reportDiscovery(state, endpointCount + bridgeCount, ctrlRequests,
+                    rssGrowthKb);
+}
+
+// {endpoints, bridges, response latency in us}. EID space of a single
+// network limits the largest case to 240 simulated endpoints
+void discoveryScaleArgs(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->Args({1, 0, 1000})
+        ->Args({10, 0, 1000})
+        ->Args({50, 2, 1000})
+        ->Args({100, 4, 1000})
+        ->Args({232, 8, 1000})
+        ->Args({232, 8, 100});
+}
+
+/*
+ * Registration of devices found by bus scan with independent queries sent
+ * one after another (0) or pipelined (1). Latency dominates, so time per
+ * device follows the number of round trips of a single registration.
+ */
+void BM_SMBusRegistrationPipelining(benchmark::State& state)
+{
+    const auto deviceCount = static_cast<size_t>(state.range(0));
+    const bool pipelined = state.range(1) != 0;
+    constexpr auto latency = std::chrono::milliseconds{1};
+
+    size_t ctrlRequests = 0;
+    double rssGrowthKb = 0;
+    for (auto _ : state)
+    {
+        RssGrowth rssGrowth;
+        SMBusDiscoveryFixture fixture(deviceCount, 0, latency, pipelined);
+        auto elapsed = fixture.discover();
+        if (!elapsed)
+        {
+            state.SkipWithError("Devices were not registered in time");
+            break;
+        }
+        state.SetIterationTime(elapsed->count());
+        ctrlRequests += fixture.responder->ctrlRequests;
+        rssGrowthKb = std::max(rssGrowthKb, rssGrowth.kb());
+    }
+
+    reportDiscovery(state, deviceCount, ctrlRequests, rssGrowthKb);
+}
+
+BENCHMARK(BM_PCIeDiscoveryScale)
+    ->Apply(discoveryScaleArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->Iterations(3);
+BENCHMARK(BM_SMBusDiscoveryScale)
+    ->Apply(discoveryScaleArgs)
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->Iterations(3);
+BENCHMARK(BM_SMBusRegistrationPipelining)
+    ->Args({20, 0})
+    ->Args({20, 1})
+    ->Unit(benchmark::kMillisecond)
+    ->UseManualTime()
+    ->Iterations(3);
+
+} // namespace
@@ -0,0 +1,123 @@
+#include "utils/DelayedResponder.hpp"
+#include "utils/pcie/PCIeDiscoveredTestBase.hpp"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+// Time taken by endpoint to answer control request
+constexpr auto responseLatency = std::chrono::milliseconds{1};
+constexpr uint16_t firstEndpointBdf = 0x0100;
+constexpr uint8_t firstEndpointEid = 0x20;
+
+/*
+ * Discovered PCIe binding on top of fake PCIe driver. Every endpoint answers
+ * Get Message Type Support and Get UUID after responseLatency, while other
+ * requests are in flight.
+ */
+class RegistrationFixture : public PCIeDiscoveredTestBase
+{
+  public:
+    RegistrationFixture() :
+        responder(ioc,
+                  std::static_pointer_cast<FakePCIeDriver>(binding->hw)->hw,
+                  responseLatency,
+                  [this](const auto& request) { respond(request); })
+    {
+    }
+
+    // Registers endpoints found in routing table and waits for all of them
+    void registerEndpoints(size_t endpointCount, size_t concurrency)
+    {
+        std::vector<TestPCIeBinding::routingTableEntry_t> table;
+        for (size_t i = 0; i < endpointCount; i++)
+        {
+            table.emplace_back(static_cast<uint8_t>(firstEndpointEid + i),
+                               static_cast<uint16_t>(firstEndpointBdf + i),
+                               MCTP_ROUTING_ENTRY_ENDPOINT);
+        }
+        const mctp_nupcie_pkt_private prv{PCIE_ROUTE_BY_ID, busOwnerBdf};
+        const auto prvPtr = reinterpret_cast<const uint8_t*>(&prv);
+        const mctpd::BindingPrivate prvData(prvPtr, prvPtr + sizeof(prv));
+
+        binding->registrationConcurrency = concurrency;
+        bool done = false;
+        schedule([&]() -> boost::asio::awaitable<void> {
+            co_await binding->processRoutingTableChanges(table, prvData);
+            done = true;
+        });
+        while (!done)
+        {
+            ioc.run_one();
+        }
+    }
+
+  private:
+    DelayedResponder responder;
+
+    void respond(const mctp_binding_fake::mctp_frame& request)
+    {
+        auto hdr =
+            reinterpret_cast<const mctp_ctrl_msg_hdr*>(request.payload.data());
+        auto prv = *reinterpret_cast<const mctp_nupcie_pkt_private*>(
+            request.privateData.data());
+
+        if (hdr->command_code == MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT)
+        {
+            auto response = binding->backdoor.prepareCtrlResponse<
+                mctp_ctrl_resp_get_msg_type_support>(request, prv,
+                                                     sizeof(msg_type_entry));
+            response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+            response.payload->msg_type_count = 1;
+            *getTypeArray(response.payload) =
+                msg_type_entry{MCTP_MESSAGE_TYPE_PLDM};
+            binding->backdoor.rx(response);
+        }
+        else if (hdr->command_code == MCTP_CTRL_CMD_GET_ENDPOINT_UUID)
+        {
+            auto response = binding->backdoor
+                                .prepareCtrlResponse<mctp_ctrl_resp_get_uuid>(
+                                    request, prv);
+            response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+            reinterpret_cast<uint8_t*>(&response.payload->uuid)[0] =
+                request.header.dest;
+            binding->backdoor.rx(response);
+        }
+    }
+};
+
+// Registration of endpoints after routing table change, with concurrency
+// limit of 1 matching the previous one by one registration
+void BM_PCIeEndpointRegistration(benchmark::State& state)
+{
+    const auto endpointCount = static_cast<size_t>(state.range(0));
+    const auto concurrency = static_cast<size_t>(state.range(1));
+
+    std::unique_ptr<RegistrationFixture> fixture;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        fixture.reset();
+        fixture = std::make_unique<RegistrationFixture>();
+        state.ResumeTiming();
+
+        fixture->registerEndpoints(endpointCount, concurrency);
+    }
+
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<int64_t>(endpointCount));
+}
+BENCHMARK(BM_PCIeEndpointRegistration)
+    ->Args({32, 1})
+    ->Args({32, 4})
+    ->Args({32, 8})
+    ->Args({32, 32})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+} // namespace
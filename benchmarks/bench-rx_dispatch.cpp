@@ -0,0 +1,110 @@
+#include "utils/rx_correlator.hpp"
+
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+constexpr mctp_eid_t firstEid = 10;
+constexpr size_t responseSize = 64;
+
+struct PendingRequest
+{
+    std::optional<std::vector<uint8_t>> response;
+};
+
+mctp_eid_t endpointFor(size_t index)
+{
+    return static_cast<mctp_eid_t>(firstEid + index);
+}
+
+void reportResponses(benchmark::State& state, size_t endpointCount)
+{
+    state.SetItemsProcessed(
+        state.iterations() *
+        static_cast<int64_t>(endpointCount * mctpd::RxCorrelator::tagCount));
+}
+
+/*
+ * Upper layer response on receive path before correlator. Payload is copied
+ * for every message, then transmission queue looks up endpoint and tag in
+ * two ordered maps.
+ */
+void BM_LegacyRxDispatch(benchmark::State& state)
+{
+    const auto endpointCount = static_cast<size_t>(state.range(0));
+    const std::vector<uint8_t> payload(responseSize, 0x01);
+    std::vector<PendingRequest> requests(endpointCount *
+                                         mctpd::RxCorrelator::tagCount);
+    std::map<mctp_eid_t, std::map<uint8_t, PendingRequest*>> endpoints;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < requests.size(); i++)
+        {
+            endpoints[endpointFor(i / mctpd::RxCorrelator::tagCount)].emplace(
+                static_cast<uint8_t>(i % mctpd::RxCorrelator::tagCount),
+                &requests[i]);
+        }
+
+        for (size_t i = 0; i < requests.size(); i++)
+        {
+            const mctp_eid_t srcEid =
+                endpointFor(i / mctpd::RxCorrelator::tagCount);
+            const auto tag =
+                static_cast<uint8_t>(i % mctpd::RxCorrelator::tagCount);
+            std::vector<uint8_t> response(payload.begin(), payload.end());
+
+            auto endpointIter = endpoints.find(srcEid);
+            auto messageIter = endpointIter->second.find(tag);
+            messageIter->second->response = std::move(response);
+            endpointIter->second.erase(messageIter);
+        }
+        benchmark::ClobberMemory();
+    }
+    reportResponses(state, endpointCount);
+}
+BENCHMARK(BM_LegacyRxDispatch)->Arg(1)->Arg(32)->Arg(250);
+
+// Single hashed lookup, payload is copied once it gets to its request
+void BM_CorrelatorRxDispatch(benchmark::State& state)
+{
+    const auto endpointCount = static_cast<size_t>(state.range(0));
+    const std::vector<uint8_t> payload(responseSize, 0x01);
+    std::vector<PendingRequest> requests(endpointCount *
+                                         mctpd::RxCorrelator::tagCount);
+    mctpd::RxCorrelator correlator;
+
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < requests.size(); i++)
+        {
+            correlator.expect(
+                endpointFor(i / mctpd::RxCorrelator::tagCount),
+                static_cast<uint8_t>(i % mctpd::RxCorrelator::tagCount),
+                [request = &requests[i]](std::span<const uint8_t> response) {
+                    request->response.emplace(response.begin(),
+                                              response.end());
+                    return true;
+                });
+        }
+
+        for (size_t i = 0; i < requests.size(); i++)
+        {
+            correlator.dispatch(
+                endpointFor(i / mctpd::RxCorrelator::tagCount),
+                static_cast<uint8_t>(i % mctpd::RxCorrelator::tagCount),
+                payload);
+        }
+        benchmark::ClobberMemory();
+    }
+    reportResponses(state, endpointCount);
+}
+BENCHMARK(BM_CorrelatorRxDispatch)->Arg(1)->Arg(32)->Arg(250);
+
+} // namespace
@@ -0,0 +1,204 @@
+#include "utils/transmission_queue.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+std::atomic<size_t> allocations{0};
+
+constexpr size_t outstandingMessages = 256;
+constexpr mctp_eid_t ownEid = 8;
+constexpr mctp_eid_t firstEid = 10;
+// Each endpoint has 8 tags, keep all messages in flight at the same time
+constexpr size_t endpointCount = outstandingMessages / 8;
+constexpr std::chrono::milliseconds timeout{1000};
+
+// Binding accepting every packet without storing it
+struct NullBinding
+{
+    NullBinding()
+    {
+        binding.name = "null";
+        binding.version = 1;
+        binding.tx = [](struct mctp_binding*, struct mctp_pktbuf*) {
+            return 0;
+        };
+        binding.pkt_size = MCTP_PACKET_SIZE(4096);
+        binding.pkt_priv_size = sizeof(uint8_t);
+
+        mctp = mctp_init();
+        mctp_register_bus(mctp, &binding, ownEid);
+        mctp_binding_set_tx_enabled(&binding, true);
+    }
+
+    ~NullBinding()
+    {
+        mctp_destroy(mctp);
+    }
+
+    mctp_binding binding{};
+    struct mctp* mctp = nullptr;
+};
+
+mctp_eid_t endpointFor(size_t index)
+{
+    return static_cast<mctp_eid_t>(firstEid + index % endpointCount);
+}
+
+void reportAllocations(benchmark::State& state, size_t allocationsBefore,
+                       size_t messageCount)
+{
+    state.SetItemsProcessed(state.iterations() *
+                            static_cast<int64_t>(messageCount));
+    state.counters["allocs/msg"] = benchmark::Counter(
+        static_cast<double>(allocations - allocationsBefore) /
+            static_cast<double>(messageCount),
+        benchmark::Counter::kAvgIterations);
+}
+
+// Timeout bookkeeping used before pooling, each message owns asio timer
+struct TimerMessage
+{
+    explicit TimerMessage(boost::asio::io_context& ioc) : timer(ioc)
+    {
+    }
+
+    boost::asio::steady_timer timer;
+};
+
+struct WheelMessage : public mctpd::TimingWheel::Entry
+{
+};
+
+void BM_PerMessageTimer(benchmark::State& state)
+{
+    const auto messageCount = static_cast<size_t>(state.range(0));
+    boost::asio::io_context ioc;
+    std::vector<std::shared_ptr<TimerMessage>> messages;
+    messages.reserve(messageCount);
+    size_t completed = 0;
+
+    const size_t allocationsBefore = allocations;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < messageCount; i++)
+        {
+            auto& message =
+                messages.emplace_back(std::make_shared<TimerMessage>(ioc));
+            // Spread deadlines as in-flight requests do
+            message->timer.expires_after(timeout +
+                                         std::chrono::microseconds{i});
+            message->timer.async_wait(
+                [&completed](boost::system::error_code) { completed++; });
+        }
+        for (auto& message : messages)
+        {
+            message->timer.cancel();
+        }
+        ioc.poll();
+        ioc.restart();
+        messages.clear();
+    }
+    benchmark::DoNotOptimize(completed);
+    reportAllocations(state, allocationsBefore, messageCount);
+}
+BENCHMARK(BM_PerMessageTimer)->Arg(16)->Arg(256)->Arg(1024);
+
+void BM_PooledTimingWheel(benchmark::State& state)
+{
+    const auto messageCount = static_cast<size_t>(state.range(0));
+    boost::asio::io_context ioc;
+    size_t completed = 0;
+    mctpd::TimingWheel wheel(ioc, [](mctpd::TimingWheel::Entry&) {});
+    auto pool = std::make_shared<mctpd::SlabPool>();
+    std::vector<std::shared_ptr<WheelMessage>> messages;
+    messages.reserve(messageCount);
+
+    const size_t allocationsBefore = allocations;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < messageCount; i++)
+        {
+            auto& message = messages.emplace_back(
+                std::allocate_shared<WheelMessage>(
+                    mctpd::PoolAllocator<WheelMessage>(pool)));
+            wheel.schedule(*message, timeout + std::chrono::microseconds{i});
+        }
+        for (auto& message : messages)
+        {
+            wheel.cancel(*message);
+            boost::asio::post(ioc, [&completed] { completed++; });
+        }
+        ioc.poll();
+        ioc.restart();
+        messages.clear();
+    }
+    benchmark::DoNotOptimize(completed);
+    reportAllocations(state, allocationsBefore, messageCount);
+}
+BENCHMARK(BM_PooledTimingWheel)->Arg(16)->Arg(256)->Arg(1024);
+
+void BM_TransmissionQueue(benchmark::State& state)
+{
+    boost::asio::io_context ioc;
+    NullBinding null;
+    mctpd::MctpTransmissionQueue queue{ioc};
+    std::vector<std::shared_ptr<mctpd::MctpTransmissionQueue::Message>>
+        messages;
+    messages.reserve(outstandingMessages);
+    size_t completed = 0;
+    const std::vector<uint8_t> response{0x01};
+
+    const size_t allocationsBefore = allocations;
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < outstandingMessages; i++)
+        {
+            auto& message = messages.emplace_back(queue.transmit(
+                null.mctp, endpointFor(i), std::vector<uint8_t>(32, 0x01),
+                mctpd::BindingPrivate(1, 0x00)));
+            queue.asyncWait(
+                message, timeout,
+                [&completed](boost::system::error_code) { completed++; });
+        }
+        for (size_t i = 0; i < outstandingMessages; i++)
+        {
+            queue.receive(endpointFor(i), messages[i]->tag.value(), response);
+        }
+        ioc.poll();
+        ioc.restart();
+        messages.clear();
+    }
+    benchmark::DoNotOptimize(completed);
+    reportAllocations(state, allocationsBefore, outstandingMessages);
+}
+BENCHMARK(BM_TransmissionQueue);
+
+} // namespace
+
+// Counts every heap allocation. Operators are kept out of line so compiler
+// does not pair inlined malloc and free with new and delete expressions.
+[[gnu::noinline]] void* operator new(size_t size)
+{
+    allocations++;
+    if (void* ptr = std::malloc(size))
+    {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+[[gnu::noinline]] void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+[[gnu::noinline]] void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
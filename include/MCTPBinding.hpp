@@ -49,6 +49,8 @@ class MctpBinding : public MCTPBridge
     std::shared_ptr<sdbusplus::asio::connection> connection;
     bool rsvBWActive = false;
     mctp_eid_t reservedEID = 0;
+    // SendReceiveMctpMessagePayload timeout is capped by RTT estimate
+    bool capClientTimeouts = false;
     mctpd::MctpTransmissionQueue transmissionQueue;
     bridging::MCTPServiceScanner mctpServiceScanner;
     // Register MCTP responder for upper layer
@@ -59,15 +61,17 @@ class MctpBinding : public MCTPBridge
     virtual void triggerDeviceDiscovery();
     virtual void addUnknownEIDToDeviceTable(const mctp_eid_t eid,
                                             void* bindingPrivate);
+    void populateTransportProperties(
+        std::shared_ptr<dbus_interface>& transportIntf,
+        const mctp_eid_t eid) override;
 
     void initializeMctp();
     bool registerUpperLayerResponder(uint8_t typeNo,
                                      std::vector<uint8_t>& list);
     bool manageVersionInfo(uint8_t typeNo, std::vector<uint8_t>& list);
     bool manageVdpciVersionInfo(uint16_t vendorId, uint16_t cmdSetType);
-    std::optional<mctp_eid_t>
-        registerEndpoint(boost::asio::yield_context& yield,
-                         const std::vector<uint8_t>& bindingPrivate,
+    boost::asio::awaitable<std::optional<mctp_eid_t>>
+        registerEndpoint(const mctpd::BindingPrivate& bindingPrivate,
                          mctp_eid_t eid,
                          mctp_server::BindingModeTypes bindingMode =
                              mctp_server::BindingModeTypes::Endpoint);
@@ -93,6 +97,12 @@ class MctpBinding : public MCTPBridge
     }
     bool setMediumId(uint8_t value,
                      mctp_server::MctpPhysicalMediumIdentifiers& mediumId);
+    // SendReceiveMctpMessagePayload D-Bus method
+    std::vector<uint8_t>
+        sendReceiveMctpMessagePayload(boost::asio::yield_context yield,
+                                      uint8_t dstEid,
+                                      std::vector<uint8_t> payload,
+                                      uint16_t timeout);
 
   private:
     bool staticEid;
@@ -8,6 +8,7 @@
 #include <libmctp-cmds.h>
 
 #include <boost/asio/deadline_timer.hpp>
+#include <deque>
 #include <xyz/openbmc_project/MCTP/Binding/PCIe/server.hpp>
 
 using pcie_binding =
@@ -55,14 +56,22 @@ class PCIeBinding : public MctpBinding,
 
     void populateDeviceProperties(
         const mctp_eid_t eid,
-        const std::vector<uint8_t>& bindingPrivate) override;
+        const mctpd::BindingPrivate& bindingPrivate) override;
+    bool isPipelinedRegistrationAllowed(
+        const mctpd::BindingPrivate& privateData) override;
+
+    using routingTableEntry_t =
+        std::tuple<uint8_t /*eid*/, uint16_t /*bdf*/, uint8_t /*entryType*/>;
+    boost::asio::awaitable<void> processRoutingTableChanges(
+        const std::vector<routingTableEntry_t>& newTable,
+        const mctpd::BindingPrivate& prvData);
+    // Upper limit of new endpoints registered at the same time
+    size_t registrationConcurrency;
 
     std::shared_ptr<hw::PCIeDriver> hw;
     std::shared_ptr<hw::DeviceMonitor> hwMonitor;
 
   private:
-    using routingTableEntry_t =
-        std::tuple<uint8_t /*eid*/, uint16_t /*bdf*/, uint8_t /*entryType*/>;
     using calledBridgeEntry_t = std::tuple<uint8_t /*eid*/, uint16_t /*bdf*/>;
     uint16_t bdf;
     uint16_t busOwnerBdf;
@@ -73,17 +82,20 @@ class PCIeBinding : public MctpBinding,
     std::vector<routingTableEntry_t> routingTable;
     void endpointDiscoveryFlow();
     void updateRoutingTable();
-    void processRoutingTableChanges(
-        const std::vector<routingTableEntry_t>& newTable,
-        boost::asio::yield_context& yield, const std::vector<uint8_t>& prvData);
-    void processBridgeEntries(std::vector<routingTableEntry_t>& rt,
-                              std::vector<calledBridgeEntry_t>& calledBridges,
-                              boost::asio::yield_context& yield);
-    void readRoutingTable(std::vector<routingTableEntry_t>& rt,
-                          std::vector<calledBridgeEntry_t>& calledBridges,
-                          std::vector<uint8_t> prvData,
-                          boost::asio::yield_context& yield, uint8_t eid,
-                          uint16_t physAddr, long entryIndex = 0);
+    boost::asio::awaitable<void>
+        registerEndpoints(std::deque<routingTableEntry_t>& pending,
+                          const mctpd::BindingPrivate& prvData);
+    boost::asio::awaitable<void>
+        registerRoutingEntry(const routingTableEntry_t& routingEntry,
+                             const mctpd::BindingPrivate& prvData);
+    boost::asio::awaitable<void>
+        processBridgeEntries(std::vector<routingTableEntry_t>& rt,
+                             std::vector<calledBridgeEntry_t>& calledBridges);
+    boost::asio::awaitable<void>
+        readRoutingTable(std::vector<routingTableEntry_t>& rt,
+                         std::vector<calledBridgeEntry_t>& calledBridges,
+                         mctpd::BindingPrivate prvData, uint8_t eid,
+                         uint16_t physAddr, long entryIndex = 0);
     uint16_t getRoutingEntryPhysAddr(
         const std::vector<uint8_t>& getRoutingTableEntryResp,
         size_t entryOffset);
@@ -100,7 +112,7 @@ class PCIeBinding : public MctpBinding,
         allBridgesCalled(const std::vector<routingTableEntry_t>& rt,
                          const std::vector<calledBridgeEntry_t>& calledBridges);
     bool setDriverEndpointMap(const std::vector<routingTableEntry_t>& newTable);
-    std::optional<std::vector<uint8_t>>
+    std::optional<mctpd::BindingPrivate>
         getBindingPrivateData(uint8_t dstEid) override;
     bool isReceivedPrivateDataCorrect(const void* bindingPrivate) override;
     mctp_server::BindingModeTypes
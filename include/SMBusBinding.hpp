@@ -28,7 +28,7 @@ class SMBusBinding : public MctpBinding
         std::shared_ptr<boost::asio::posix::stream_descriptor>&& i2cMuxMonitor);
     ~SMBusBinding() override;
     void initializeBinding() override;
-    std::optional<std::vector<uint8_t>>
+    std::optional<mctpd::BindingPrivate>
         getBindingPrivateData(uint8_t dstEid) override;
     bool handleGetEndpointId(mctp_eid_t destEid, void* bindingPrivate,
                              std::vector<uint8_t>& request,
@@ -51,12 +51,20 @@ class SMBusBinding : public MctpBinding
 
     void populateDeviceProperties(
         const mctp_eid_t eid,
-        const std::vector<uint8_t>& bindingPrivate) override;
+        const mctpd::BindingPrivate& bindingPrivate) override;
     std::optional<std::string>
-        getLocationCode(const std::vector<uint8_t>& bindingPrivate) override;
+        getLocationCode(const mctpd::BindingPrivate& bindingPrivate) override;
     void updateRoutingTableEntry(
         mctpd::RoutingTable::Entry entry,
-        const std::vector<uint8_t>& privateData) override;
+        const mctpd::BindingPrivate& privateData) override;
+    bool isPipelinedRegistrationAllowed(
+        const mctpd::BindingPrivate& privateData) override;
+
+  protected:
+    // Registers devices given by fd and 7 bit slave address, which were found
+    // by scanning the bus
+    boost::asio::awaitable<void> registerDevices(
+        const std::set<std::pair<int, uint8_t>>& registerDeviceMap);
 
   private:
     using DeviceTableEntry_t =
@@ -64,7 +72,7 @@ class SMBusBinding : public MctpBinding
                   struct mctp_smbus_pkt_private /*binding prv data*/>;
     std::string SMBusInit();
     void readResponse();
-    void initEndpointDiscovery(boost::asio::yield_context& yield);
+    boost::asio::awaitable<void> initEndpointDiscovery();
     bool reserveBandwidth(const mctp_eid_t eid,
                           const uint16_t timeout) override;
     void startTimerAndReleaseBW(const uint16_t interval,
@@ -84,6 +92,9 @@ class SMBusBinding : public MctpBinding
     bool isMuxFd(const int fd);
     std::vector<DeviceTableEntry_t> smbusDeviceTable;
     uint64_t scanInterval;
+    bool incrementalRediscovery;
+    // Control requests sent by the latest successful registration
+    size_t registrationRequests{0};
     boost::asio::steady_timer scanTimer;
     std::map<int, int> muxPortMap;
     std::set<std::pair<int, uint8_t>> rootDeviceMap;
@@ -105,7 +116,10 @@ class SMBusBinding : public MctpBinding
                   std::set<std::pair<int, uint8_t>>& deviceMap);
     void scanMuxBus(std::set<std::pair<int, uint8_t>>& deviceMap);
     mctp_eid_t
-        getEIDFromDeviceTable(const std::vector<uint8_t>& bindingPrivate);
+        getEIDFromDeviceTable(const mctpd::BindingPrivate& bindingPrivate);
+    boost::asio::awaitable<bool>
+        isRegisteredDeviceAlive(const mctpd::BindingPrivate& bindingPrivate,
+                                const mctp_eid_t eid);
     void removeDeviceTableEntry(const mctp_eid_t eid);
     void updateDiscoveredFlag(DiscoveryFlags flag);
     std::string convertToString(DiscoveryFlags flag);
@@ -120,9 +134,9 @@ class SMBusBinding : public MctpBinding
     bool isBindingDataSame(const mctp_smbus_pkt_private& dataMain,
                            const mctp_smbus_pkt_private& dataTmp);
     void updateRoutingTable();
-    void processRoutingTableChanges(
+    boost::asio::awaitable<void> processRoutingTableChanges(
         const std::vector<DeviceTableEntry_t>& newTable,
-        boost::asio::yield_context& yield, const std::vector<uint8_t>& prvData);
+        const mctpd::BindingPrivate& prvData);
     void setMuxIdleMode(const MuxIdleModes mode);
     size_t ret = 0;
 };
@@ -17,28 +17,10 @@
 #pragma once
 
 #include "mctp_endpoint.hpp"
+#include "utils/capability_cache.hpp"
 #include "utils/device_watcher.hpp"
 #include "utils/eid_pool.hpp"
 
-struct MsgTypeSupportCtrlResp
-{
-    mctp_ctrl_msg_hdr ctrlMsgHeader;
-    uint8_t completionCode;
-    uint8_t msgTypeCount;
-    std::vector<uint8_t> msgType;
-};
-
-// VendorPCI ID Support Structure
-struct MctpVendIdMsgSupportResp
-{
-    mctp_ctrl_msg_hdr ctrlMsgHeader;
-    uint8_t completionCode;
-    uint8_t vendorIdSet;
-    uint8_t vendorIdFormat;
-    uint16_t vendorIdFormatData;
-    uint16_t vendorIdSetCmdType;
-};
-
 // Bridge is both BusOwner and Endpoint
 class MCTPBridge : public MCTPEndpoint
 {
@@ -48,60 +30,63 @@ class MCTPBridge : public MCTPEndpoint
     MCTPBridge() = delete;
     ~MCTPBridge() = default;
 
+    // Capabilities of registered endpoints are kept in given file
+    bool loadCapabilityCache(const std::filesystem::path& file);
+
   protected:
     mctpd::EidPool eidPool;
     mctpd::DeviceWatcher deviceWatcher{};
+    mctpd::CapabilityCache capabilityCache;
 
-    bool getEidCtrlCmd(boost::asio::yield_context& yield,
-                       const std::vector<uint8_t>& bindingPrivate,
+    boost::asio::awaitable<bool>
+        getEidCtrlCmd(const mctpd::BindingPrivate& bindingPrivate,
+                      const mctp_eid_t destEid, std::vector<uint8_t>& resp);
+    boost::asio::awaitable<bool>
+        setEidCtrlCmd(const mctpd::BindingPrivate& bindingPrivate,
+                      const mctp_eid_t destEid,
+                      const mctp_ctrl_cmd_set_eid_op operation, mctp_eid_t eid,
+                      std::vector<uint8_t>& resp);
+    boost::asio::awaitable<bool>
+        getUuidCtrlCmd(const mctpd::BindingPrivate& bindingPrivate,
                        const mctp_eid_t destEid, std::vector<uint8_t>& resp);
-    bool setEidCtrlCmd(boost::asio::yield_context& yield,
-                       const std::vector<uint8_t>& bindingPrivate,
-                       const mctp_eid_t destEid,
-                       const mctp_ctrl_cmd_set_eid_op operation, mctp_eid_t eid,
-                       std::vector<uint8_t>& resp);
-    bool getUuidCtrlCmd(boost::asio::yield_context& yield,
-                        const std::vector<uint8_t>& bindingPrivate,
-                        const mctp_eid_t destEid, std::vector<uint8_t>& resp);
-    bool getMsgTypeSupportCtrlCmd(boost::asio::yield_context& yield,
-                                  const std::vector<uint8_t>& bindingPrivate,
-                                  const mctp_eid_t destEid,
-                                  MsgTypeSupportCtrlResp* msgTypeSupportResp);
-    bool getMctpVersionSupportCtrlCmd(
-        boost::asio::yield_context& yield,
-        const std::vector<uint8_t>& bindingPrivate, const mctp_eid_t destEid,
-        uint8_t msgTypeNo,
-        MctpVersionSupportCtrlResp* mctpVersionSupportCtrlResp);
-    void
-        getVendorDefinedMessageTypes(boost::asio::yield_context yield,
-                                     const std::vector<uint8_t>& bindingPrivate,
-                                     mctp_eid_t destEid,
-                                     EndpointProperties& epProperties);
+    // Returned views decode the response in place, it is stored in resp
+    boost::asio::awaitable<std::optional<mctpd::MsgTypeSupportView>>
+        getMsgTypeSupportCtrlCmd(const mctpd::BindingPrivate& bindingPrivate,
+                                 const mctp_eid_t destEid,
+                                 std::vector<uint8_t>& resp);
+    boost::asio::awaitable<std::optional<mctpd::VersionSupportView>>
+        getMctpVersionSupportCtrlCmd(
+            const mctpd::BindingPrivate& bindingPrivate,
+            const mctp_eid_t destEid, uint8_t msgTypeNo,
+            std::vector<uint8_t>& resp);
+    boost::asio::awaitable<void> getVendorDefinedMessageTypes(
+        const mctpd::BindingPrivate& bindingPrivate, mctp_eid_t destEid,
+        EndpointProperties& epProperties);
     // vendor PCI ID Function
-    bool getPCIVDMessageSupportCtrlCmd(
-        boost::asio::yield_context& yield,
-        const std::vector<uint8_t>& bindingPrivate, const mctp_eid_t destEid,
+    boost::asio::awaitable<bool> getPCIVDMessageSupportCtrlCmd(
+        const mctpd::BindingPrivate& bindingPrivate, const mctp_eid_t destEid,
         std::vector<uint16_t>& vendorSetIdList, std::string& venformat);
-    bool getRoutingTableCtrlCmd(boost::asio::yield_context& yield,
-                                const std::vector<uint8_t>& bindingPrivate,
-                                const mctp_eid_t destEid, uint8_t entryHandle,
-                                std::vector<uint8_t>& resp);
+    boost::asio::awaitable<bool>
+        getRoutingTableCtrlCmd(const mctpd::BindingPrivate& bindingPrivate,
+                               const mctp_eid_t destEid, uint8_t entryHandle,
+                               std::vector<uint8_t>& resp);
     //   private:
-    std::optional<mctp_eid_t>
-        busOwnerRegisterEndpoint(boost::asio::yield_context& yield,
-                                 const std::vector<uint8_t>& bindingPrivate,
+    boost::asio::awaitable<std::optional<mctp_eid_t>>
+        busOwnerRegisterEndpoint(const mctpd::BindingPrivate& bindingPrivate,
                                  mctp_eid_t eid);
     void sendRoutingTableEntriesToBridge(
-        const mctp_eid_t bridge, const std::vector<uint8_t>& bindingPrivate);
+        const mctp_eid_t bridge, const mctpd::BindingPrivate& bindingPrivate);
     void sendNewRoutingTableEntryToAllBridges(
         const mctpd::RoutingTable::Entry& entry);
 
   private:
     void logUnsupportedMCTPVersion(
-        const std::vector<struct MCTPVersionFields> versionsData,
-        const mctp_eid_t eid);
+        const std::vector<MCTPVersionFields>& versions, const mctp_eid_t eid);
+    boost::asio::awaitable<void> refreshCapabilities(
+        mctpd::BindingPrivate bindingPrivate, mctp_eid_t eid, std::string uuid,
+        mctpd::CapabilityCache::Entry published);
     void sendRoutingTableEntries(
         const std::vector<mctpd::RoutingTable::Entry::MCTPLibData>& entries,
-        std::optional<std::vector<uint8_t>> bindingPrivateData,
+        std::optional<mctpd::BindingPrivate> bindingPrivateData,
         const mctp_eid_t eid = 0);
 };
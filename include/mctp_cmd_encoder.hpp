@@ -16,140 +16,135 @@
 
 #pragma once
 
+#include "utils/ctrl_resp_view.hpp"
+
+#include <algorithm>
+#include <array>
+#include <boost/container/small_vector.hpp>
+#include <optional>
 #include <phosphor-logging/log.hpp>
+#include <span>
+#include <vector>
 
 #include "libmctp-cmds.h"
 
 constexpr size_t minCmdRespSize = 4;
 
-static uint8_t createInstanceId()
+// Instance ID is allocated per destination EID when request is queued for
+// transmission, see MCTPDevice::pushToCtrlTxQueue
+static uint8_t getRqDgramInst()
 {
-    static uint8_t instanceId = 0x00;
-
-    instanceId = (instanceId + 1) & MCTP_CTRL_HDR_INSTANCE_ID_MASK;
-    return instanceId;
+    return MCTP_CTRL_HDR_FLAG_REQUEST;
 }
 
-static uint8_t getRqDgramInst()
+/*
+ * Request structure and libmctp encoder of every fixed size control command.
+ * Commands without specialization cannot be formatted by getFormattedReq.
+ */
+template <int cmd>
+struct CtrlReqFormat;
+
+template <>
+struct CtrlReqFormat<MCTP_CTRL_CMD_GET_ENDPOINT_ID>
 {
-    uint8_t instanceID = createInstanceId();
-    uint8_t rqDgramInst = instanceID | MCTP_CTRL_HDR_FLAG_REQUEST;
-    return rqDgramInst;
-}
+    using type = mctp_ctrl_cmd_get_eid;
+    static constexpr auto encode = mctp_encode_ctrl_cmd_get_eid;
+};
 
-template <int cmd, typename... Args>
-bool getFormattedReq(std::vector<uint8_t>& req, Args&&... reqParam)
+template <>
+struct CtrlReqFormat<MCTP_CTRL_CMD_SET_ENDPOINT_ID>
 {
-    if constexpr (cmd == MCTP_CTRL_CMD_GET_ENDPOINT_ID)
-    {
-        req.resize(sizeof(mctp_ctrl_cmd_get_eid));
-        mctp_ctrl_cmd_get_eid* getEidCmd =
-            reinterpret_cast<mctp_ctrl_cmd_get_eid*>(req.data());
+    using type = mctp_ctrl_cmd_set_eid;
+    static constexpr auto encode = mctp_encode_ctrl_cmd_set_eid;
+};
 
-        mctp_encode_ctrl_cmd_get_eid(getEidCmd, getRqDgramInst());
-        return true;
-    }
-    else if constexpr (cmd == MCTP_CTRL_CMD_SET_ENDPOINT_ID)
-    {
-        req.resize(sizeof(mctp_ctrl_cmd_set_eid));
-        mctp_ctrl_cmd_set_eid* setEidCmd =
-            reinterpret_cast<mctp_ctrl_cmd_set_eid*>(req.data());
+template <>
+struct CtrlReqFormat<MCTP_CTRL_CMD_GET_ENDPOINT_UUID>
+{
+    using type = mctp_ctrl_cmd_get_uuid;
+    static constexpr auto encode = mctp_encode_ctrl_cmd_get_uuid;
+};
 
-        mctp_encode_ctrl_cmd_set_eid(setEidCmd, getRqDgramInst(),
-                                     std::forward<Args>(reqParam)...);
-        return true;
-    }
-    else if constexpr (cmd == MCTP_CTRL_CMD_GET_ENDPOINT_UUID)
-    {
-        req.resize(sizeof(mctp_ctrl_cmd_get_uuid));
-        mctp_ctrl_cmd_get_uuid* getUuid =
-            reinterpret_cast<mctp_ctrl_cmd_get_uuid*>(req.data());
+template <>
+struct CtrlReqFormat<MCTP_CTRL_CMD_GET_VERSION_SUPPORT>
+{
+    using type = mctp_ctrl_cmd_get_mctp_ver_support;
+    static constexpr auto encode = mctp_encode_ctrl_cmd_get_ver_support;
+};
 
-        mctp_encode_ctrl_cmd_get_uuid(getUuid, getRqDgramInst());
-        return true;
-    }
-    else if constexpr (cmd == MCTP_CTRL_CMD_GET_VERSION_SUPPORT)
-    {
-        req.resize(sizeof(mctp_ctrl_cmd_get_mctp_ver_support));
-        mctp_ctrl_cmd_get_mctp_ver_support* getVerSupport =
-            reinterpret_cast<mctp_ctrl_cmd_get_mctp_ver_support*>(req.data());
+template <>
+struct CtrlReqFormat<MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT>
+{
+    using type = mctp_ctrl_cmd_get_msg_type_support;
+    static constexpr auto encode = mctp_encode_ctrl_cmd_get_msg_type_support;
+};
 
-        mctp_encode_ctrl_cmd_get_ver_support(getVerSupport, getRqDgramInst(),
-                                             std::forward<Args>(reqParam)...);
-        return true;
-    }
+template <>
+struct CtrlReqFormat<MCTP_CTRL_CMD_GET_VENDOR_MESSAGE_SUPPORT>
+{
+    using type = struct mctp_ctrl_cmd_get_vdm_support;
+    static constexpr auto encode = mctp_encode_ctrl_cmd_get_vdm_support;
+};
 
-    else if constexpr (cmd == MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT)
-    {
-        req.resize(sizeof(mctp_ctrl_cmd_get_msg_type_support));
-        mctp_ctrl_cmd_get_msg_type_support* getMsgType =
-            reinterpret_cast<mctp_ctrl_cmd_get_msg_type_support*>(req.data());
+template <>
+struct CtrlReqFormat<MCTP_CTRL_CMD_DISCOVERY_NOTIFY>
+{
+    using type = mctp_ctrl_cmd_discovery_notify;
+    static constexpr auto encode = mctp_encode_ctrl_cmd_discovery_notify;
+};
 
-        mctp_encode_ctrl_cmd_get_msg_type_support(getMsgType, getRqDgramInst());
-        return true;
-    }
-    else if constexpr (cmd == MCTP_CTRL_CMD_GET_VENDOR_MESSAGE_SUPPORT)
-    {
-        req.resize(sizeof(struct mctp_ctrl_cmd_get_vdm_support));
-        struct mctp_ctrl_cmd_get_vdm_support* getVdmSupport =
-            reinterpret_cast<struct mctp_ctrl_cmd_get_vdm_support*>(req.data());
+template <>
+struct CtrlReqFormat<MCTP_CTRL_CMD_GET_ROUTING_TABLE_ENTRIES>
+{
+    using type = mctp_ctrl_cmd_get_routing_table;
+    static constexpr auto encode = mctp_encode_ctrl_cmd_get_routing_table;
+};
+
+// Request of given command, its size is known at compile time
+template <int cmd>
+using CtrlReq = std::array<uint8_t, sizeof(typename CtrlReqFormat<cmd>::type)>;
+
+// Largest fixed size request
+constexpr size_t maxCtrlReqSize =
+    std::max({sizeof(mctp_ctrl_cmd_get_eid), sizeof(mctp_ctrl_cmd_set_eid),
+              sizeof(mctp_ctrl_cmd_get_uuid),
+              sizeof(mctp_ctrl_cmd_get_mctp_ver_support),
+              sizeof(mctp_ctrl_cmd_get_msg_type_support),
+              sizeof(struct mctp_ctrl_cmd_get_vdm_support),
+              sizeof(mctp_ctrl_cmd_discovery_notify),
+              sizeof(mctp_ctrl_cmd_get_routing_table)});
 
-        mctp_encode_ctrl_cmd_get_vdm_support(getVdmSupport, getRqDgramInst(),
-                                             std::forward<Args>(reqParam)...);
-        return true;
-    }
-    else if constexpr (cmd == MCTP_CTRL_CMD_DISCOVERY_NOTIFY)
-    {
-        req.resize(sizeof(mctp_ctrl_cmd_discovery_notify));
-        mctp_ctrl_cmd_discovery_notify* discoveryNotify =
-            reinterpret_cast<mctp_ctrl_cmd_discovery_notify*>(req.data());
+/*
+ * Pending control request. Fixed size requests are kept inline, only
+ * variable length ones like Routing Information Update use the heap.
+ */
+using CtrlReqBuffer = boost::container::small_vector<uint8_t, maxCtrlReqSize>;
 
-        mctp_encode_ctrl_cmd_discovery_notify(discoveryNotify,
-                                              getRqDgramInst());
-        return true;
-    }
-    else if constexpr (cmd == MCTP_CTRL_CMD_GET_ROUTING_TABLE_ENTRIES)
-    {
-        req.resize(sizeof(mctp_ctrl_cmd_get_routing_table));
-        mctp_ctrl_cmd_get_routing_table* getRoutingTable =
-            reinterpret_cast<mctp_ctrl_cmd_get_routing_table*>(req.data());
+template <int cmd, typename... Args>
+std::optional<CtrlReq<cmd>> getFormattedReq(Args&&... reqParam)
+{
+    using Format = CtrlReqFormat<cmd>;
 
-        mctp_encode_ctrl_cmd_get_routing_table(
-            getRoutingTable, getRqDgramInst(), std::forward<Args>(reqParam)...);
-        return true;
-    }
-    else
+    CtrlReq<cmd> req{};
+    auto* cmdPtr = reinterpret_cast<typename Format::type*>(req.data());
+    if (!Format::encode(cmdPtr, getRqDgramInst(),
+                        std::forward<Args>(reqParam)...))
     {
-        phosphor::logging::log<phosphor::logging::level::ERR>(
-            "Control command not defined");
-        return false;
+        return std::nullopt;
     }
+    return req;
 }
 
-static bool checkMinRespSize(const std::vector<uint8_t>& resp)
+inline bool checkMinRespSize(const std::vector<uint8_t>& resp)
 {
     return (resp.size() >= minCmdRespSize);
 }
 
+// Fixed size response, validated the same way as responses with lists
 template <typename structure>
-static bool checkRespSizeAndCompletionCode(std::vector<uint8_t>& resp)
+static bool checkRespSizeAndCompletionCode(std::span<const uint8_t> resp)
 {
-    if (!checkMinRespSize(resp))
-    {
-        phosphor::logging::log<phosphor::logging::level::ERR>(
-            "Invalid response length");
-        return false;
-    }
-
-    structure* respPtr = reinterpret_cast<structure*>(resp.data());
-
-    if (respPtr->completion_code != MCTP_CTRL_CC_SUCCESS ||
-        resp.size() != sizeof(structure))
-    {
-        phosphor::logging::log<phosphor::logging::level::ERR>(
-            "Invalid response", phosphor::logging::entry("LEN=%d", resp.size()),
-            phosphor::logging::entry("CC=0x%02X", respPtr->completion_code));
-        return false;
-    }
-    return true;
+    return mctpd::CtrlRespView::decode(resp, sizeof(structure),
+                                       sizeof(structure))
+        .has_value();
 }
\ No newline at end of file
@@ -16,6 +16,7 @@
 
 #pragma once
 
+#include "utils/binding_private.hpp"
 #include "utils/types.hpp"
 
 #include <libmctp.h>
@@ -84,13 +85,25 @@ class MCTPDBusInterfaces
     endpointInterfaceMap endpointInterface;
     endpointInterfaceMap msgTypeInterface;
     endpointInterfaceMap uuidInterface;
+    // Transmission state of the endpoint, e.g. in-flight window
+    endpointInterfaceMap transportInterface;
 
     virtual void
         populateDeviceProperties(const mctp_eid_t eid,
-                                 const std::vector<uint8_t>& bindingPrivate);
+                                 const mctpd::BindingPrivate& bindingPrivate);
+    virtual void populateTransportProperties(
+        std::shared_ptr<dbus_interface>& transportIntf, const mctp_eid_t eid);
 
     bool removeInterface(mctp_eid_t eid, endpointInterfaceMap& interfaces);
     void registerMsgTypes(std::shared_ptr<dbus_interface>& msgTypeIntf,
                           const MsgTypes& messageType);
     void populateEndpointProperties(const EndpointProperties& epProperties);
+    // Replaces message type and vendor defined message interfaces of endpoint
+    void updateCapabilityProperties(const EndpointProperties& epProperties);
+
+  private:
+    void populateVendorIdProperties(const std::string& mctpEpObj,
+                                    const EndpointProperties& epProperties);
+    void populateMsgTypeProperties(const std::string& mctpEpObj,
+                                   const EndpointProperties& epProperties);
 };
@@ -16,12 +16,28 @@
 
 #pragma once
 
+#include "mctp_cmd_encoder.hpp"
 #include "mctp_dbus_interfaces.hpp"
 #include "routing_table.hpp"
+#include "utils/circuit_breaker.hpp"
+#include "utils/ctrl_resp_view.hpp"
+#include "utils/instance_id_pool.hpp"
+#include "utils/retry_policy.hpp"
+#include "utils/rtt_estimator.hpp"
+#include "utils/rx_correlator.hpp"
 
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/steady_timer.hpp>
 #include <boost/asio/detached.hpp>
+#include <deque>
+#include <functional>
+#include <map>
+#include <random>
+#include <span>
 
 enum class PacketState : uint8_t
 {
@@ -32,22 +48,6 @@ enum class PacketState : uint8_t
     noResponse
 };
 
-struct MCTPVersionFields
-{
-    uint8_t major;
-    uint8_t minor;
-    uint8_t update;
-    uint8_t alpha;
-};
-
-struct MctpVersionSupportCtrlResp
-{
-    mctp_ctrl_msg_hdr ctrlMsgHeader;
-    uint8_t completionCode;
-    uint8_t verNoEntryCount;
-    std::vector<struct MCTPVersionFields> verNoEntry;
-};
-
 class MCTPDevice : public MCTPDBusInterfaces
 {
   public:
@@ -61,6 +61,13 @@ class MCTPDevice : public MCTPDBusInterfaces
     uint8_t ownEid;
     uint8_t ctrlTxRetryCount;
     unsigned int ctrlTxRetryDelay;
+    // Overrides ctrlTxRetryDelay and ctrlTxRetryCount per command class
+    std::map<mctpd::CtrlCommandClass, mctpd::RetryPolicy> ctrlRetryPolicies;
+    // Round trip time per EID, sets first control timeout when adaptive
+    mctpd::RttEstimator rttEstimator;
+    bool adaptiveTimeouts{false};
+    // Fails requests to endpoints which stopped responding
+    mctpd::CircuitBreaker circuitBreaker;
     mctp_server::BindingModeTypes bindingModeType{};
     mctp_server::MctpPhysicalMediumIdentifiers bindingMediumID{};
     mctpd::RoutingTable routingTable;
@@ -72,19 +79,64 @@ class MCTPDevice : public MCTPDBusInterfaces
     struct mctp* mctp = nullptr;
 
     virtual std::optional<std::string>
-        getLocationCode(const std::vector<uint8_t>& bindingPrivate);
+        getLocationCode(const mctpd::BindingPrivate& bindingPrivate);
     virtual void
         updateRoutingTableEntry(mctpd::RoutingTable::Entry entry,
-                                const std::vector<uint8_t>& privateData);
-    virtual std::optional<std::vector<uint8_t>>
+                                const mctpd::BindingPrivate& privateData);
+    virtual std::optional<mctpd::BindingPrivate>
         getBindingPrivateData(uint8_t dstEid);
+    // Whether independent control requests to a device being registered may
+    // be outstanding at the same time
+    virtual bool isPipelinedRegistrationAllowed(
+        const mctpd::BindingPrivate& privateData);
+    // Runs on every ctrlTxTimer wakeup
+    virtual void processCtrlTxQueue();
+
+    void addRttSample(mctp_eid_t eid, std::chrono::microseconds rtt);
+    void addRttTimeout(mctp_eid_t eid);
+
+    /*
+     * Sends control request and completes once, with the response or with
+     * timed_out error after all retries. Handler signature is
+     * void(boost::system::error_code, std::vector<uint8_t> response).
+     */
+    template <typename CompletionToken>
+    auto asyncSendAndRcvMctpCtrl(std::span<const uint8_t> req,
+                                 const mctp_eid_t destEid,
+                                 const mctpd::BindingPrivate& bindingPrivate,
+                                 CompletionToken&& token)
+    {
+        return boost::asio::async_initiate<
+            CompletionToken,
+            void(boost::system::error_code, std::vector<uint8_t>)>(
+            [this, req, destEid, &bindingPrivate](auto handler) {
+                CtrlTxCallback callback =
+                    [this, handler = std::move(handler)](
+                        PacketState state,
+                        std::vector<uint8_t>& response) mutable {
+                        boost::asio::post(
+                            io, [handler = std::move(handler),
+                                 ec = getCtrlTxErrorCode(state),
+                                 response = std::move(response)]() mutable {
+                                handler(ec, std::move(response));
+                            });
+                    };
 
-    PacketState sendAndRcvMctpCtrl(boost::asio::yield_context& yield,
-                                   const std::vector<uint8_t>& req,
-                                   const mctp_eid_t destEid,
-                                   const std::vector<uint8_t>& bindingPrivate,
-                                   std::vector<uint8_t>& resp);
-    bool handleCtrlResp(void* msg, const size_t len);
+                if (req.size() < sizeof(mctp_ctrl_msg_hdr) ||
+                    !pushToCtrlTxQueue(destEid, bindingPrivate, req,
+                                       std::move(callback)))
+                {
+                    std::vector<uint8_t> response{};
+                    callback(PacketState::invalidPacket, response);
+                }
+            },
+            token);
+    }
+    boost::asio::awaitable<PacketState>
+        sendAndRcvMctpCtrl(std::span<const uint8_t> req,
+                           const mctp_eid_t destEid,
+                           const mctpd::BindingPrivate& bindingPrivate,
+                           std::vector<uint8_t>& resp);
     bool isEIDRegistered(mctp_eid_t eid);
     bool isEIDMappedToUUID(const mctp_eid_t eid, const std::string& destUUID);
     std::optional<mctp_eid_t> getEIDFromUUID(const std::string& uuidStr);
@@ -92,28 +144,85 @@ class MCTPDevice : public MCTPDBusInterfaces
     std::optional<mctp_eid_t>
         getEIDForReregistration(const std::string& destUUID);
     mctp_server::BindingModeTypes getEndpointType(const uint8_t types);
-    MsgTypes getMsgTypes(const std::vector<uint8_t>& msgType);
+    MsgTypes getMsgTypes(std::span<const uint8_t> msgType);
     bool isMCTPVersionSupported(const MCTPVersionFields& version);
 
+    // Control requests put on the bus, retransmissions included
+    size_t ctrlRequestsSent = 0;
+
+    // Message tags and responses of all requests sent by this terminus
+    std::shared_ptr<mctpd::RxCorrelator> correlator =
+        std::make_shared<mctpd::RxCorrelator>();
+
   private:
-    bool ctrlTxTimerExpired = true;
+    using CtrlTxCallback =
+        std::move_only_function<void(PacketState, std::vector<uint8_t>&)>;
+
     boost::asio::steady_timer ctrlTxTimer;
-    // <state, retryCount, maxRespDelay, destEid, BindingPrivate, ReqPacket,
-    //  Callback>
-    std::vector<
-        std::tuple<PacketState, uint8_t, unsigned int, mctp_eid_t,
-                   std::vector<uint8_t>, std::vector<uint8_t>,
-                   std::function<void(PacketState, std::vector<uint8_t>&)>>>
-        ctrlTxQueue;
+    std::optional<std::chrono::steady_clock::time_point> ctrlTxTimerExpiry;
+
+    // Destination EID and Msg Tag, which is unique while request is pending
+    using CtrlTxKey = uint16_t;
+    using CtrlTxDeadlines =
+        std::multimap<std::chrono::steady_clock::time_point, CtrlTxKey>;
+
+    struct CtrlTransaction
+    {
+        mctpd::RetryPolicy policy;
+        uint8_t attempt;
+        std::chrono::steady_clock::time_point sentAt;
+        // Request is retransmitted or expires at its deadline
+        CtrlTxDeadlines::iterator deadline;
+        // Policy deadline, request is not retransmitted past it
+        std::optional<std::chrono::steady_clock::time_point> expiry;
+        mctp_eid_t destEid;
+        uint8_t msgTag;
+        uint8_t instanceId;
+        mctpd::BindingPrivate bindingPrivate;
+        CtrlReqBuffer req;
+        CtrlTxCallback callback;
+    };
+
+    std::unordered_map<CtrlTxKey, CtrlTransaction> ctrlTxTable;
+    CtrlTxDeadlines ctrlTxDeadlines;
+
+    // Request which found every tag of its destination taken. Sent in order
+    // of arrival once a tag is released, or completes with no response when
+    // none is released before its expiry.
+    struct CtrlTagWaiter
+    {
+        std::chrono::steady_clock::time_point expiry;
+        mctp_eid_t destEid;
+        mctpd::BindingPrivate bindingPrivate;
+        CtrlReqBuffer req;
+        CtrlTxCallback callback;
+    };
+    std::deque<CtrlTagWaiter> ctrlTagWaiters;
+    size_t releaseObserverId;
+    mctpd::InstanceIdPool instanceIds;
+    std::minstd_rand retryJitter{std::random_device{}()};
+
+    static boost::system::error_code getCtrlTxErrorCode(PacketState state);
+    static mctpd::CtrlCommandClass getCtrlCommandClass(uint8_t commandCode);
+    mctpd::RetryPolicy
+        getRetryPolicy(mctpd::CtrlCommandClass commandClass) const;
+    static CtrlTxKey getCtrlTxKey(mctp_eid_t eid, uint8_t msgTag);
+    bool handleCtrlResp(CtrlTxKey key, std::span<const uint8_t> response);
+    void removeCtrlTransaction(
+        std::unordered_map<CtrlTxKey, CtrlTransaction>::iterator it);
 
+    void publishRttEstimate(
+        mctp_eid_t eid,
+        const std::optional<mctpd::RttEstimator::Estimate>& previous);
     void initializeLogging();
-    void processCtrlTxQueue();
-    bool sendMctpCtrlMessage(mctp_eid_t destEid, std::vector<uint8_t> req,
+    void armCtrlTxTimer();
+    bool sendMctpCtrlMessage(mctp_eid_t destEid, CtrlReqBuffer& req,
                              bool tagOwner, uint8_t msgTag,
-                             std::vector<uint8_t> bindingPrivate);
-    void pushToCtrlTxQueue(
-        PacketState pktState, const mctp_eid_t destEid,
-        const std::vector<uint8_t>& bindingPrivate,
-        const std::vector<uint8_t>& req,
-        std::function<void(PacketState, std::vector<uint8_t>&)>& callback);
+                             mctpd::BindingPrivate& bindingPrivate);
+    bool pushToCtrlTxQueue(const mctp_eid_t destEid,
+                           const mctpd::BindingPrivate& bindingPrivate,
+                           std::span<const uint8_t> req,
+                           CtrlTxCallback&& callback);
+    void onTagReleased(mctp_eid_t eid);
+    void sendCtrlTagWaiter(mctp_eid_t eid);
 };
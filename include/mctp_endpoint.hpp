@@ -56,9 +56,9 @@ class MCTPEndpoint : public MCTPDevice
         mctp_eid_t destEid, void* bindingPrivate, std::vector<uint8_t>& request,
         std::vector<uint8_t>& response);
 
-    bool discoveryNotifyCtrlCmd(boost::asio::yield_context& yield,
-                                const std::vector<uint8_t>& bindingPrivate,
-                                const mctp_eid_t destEid);
+    boost::asio::awaitable<bool>
+        discoveryNotifyCtrlCmd(const mctpd::BindingPrivate& bindingPrivate,
+                               const mctp_eid_t destEid);
     std::vector<uint8_t> getBindingMsgTypes();
     void handleCtrlReq(uint8_t destEid, void* bindingPrivate, const void* req,
                        size_t len, uint8_t msgTag);
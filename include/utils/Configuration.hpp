@@ -1,10 +1,13 @@
 #pragma once
 
+#include "utils/retry_policy.hpp"
 #include "utils/types.hpp"
 
 #include <filesystem>
+#include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 struct Configuration
 {
@@ -13,7 +16,32 @@ struct Configuration
     uint8_t defaultEid;
     unsigned int reqToRespTime;
     uint8_t reqRetryCount;
+    // Control request retries per command class, classes which are not
+    // listed follow reqToRespTime and reqRetryCount
+    std::map<mctpd::CtrlCommandClass, mctpd::RetryPolicy> ctrlRetryPolicies;
+    // Timeouts derived from round trip time estimated per EID
+    bool adaptiveTimeouts = false;
+    bool capClientTimeouts = false;
+    unsigned int adaptiveTimeoutMinMs = 10;
+    unsigned int adaptiveTimeoutMaxMs = 5000;
     std::set<std::string> allowedBuses;
+    // Transmission queue scheduling
+    std::map<uint8_t, unsigned int> endpointWeights;
+    unsigned int maxInFlightMessages = 0;
+    std::vector<uint8_t> priorityMessageTypes;
+    unsigned int starvationTimeoutMs = 1000;
+    unsigned int maxQueuedMessagesPerEid = 64;
+    unsigned int maxQueuedMessages = 512;
+    unsigned int txRetryCount = 3;
+    unsigned int txRetryDelayMs = 10;
+    unsigned int tagQuarantineMs = 500;
+    bool matchPldmInstanceId = true;
+    bool adaptiveInFlightWindow = false;
+    uint8_t initialInFlightWindow = 8;
+    unsigned int circuitBreakerThreshold = 5;
+    unsigned int circuitBreakerProbeIntervalMs = 5000;
+    // Endpoint capabilities persisted across restarts
+    bool capabilityCache = true;
 
     virtual ~Configuration();
 };
@@ -27,6 +55,8 @@ struct SMBusConfiguration : Configuration
     std::set<uint8_t> supportedEndpointSlaveAddress;
     uint8_t routingIntervalSec;
     uint64_t scanInterval;
+    // Registered devices are only checked for liveness on periodic scans
+    bool incrementalRediscovery = true;
 
     ~SMBusConfiguration() override;
 };
@@ -35,6 +65,8 @@ struct PcieConfiguration : Configuration
 {
     uint16_t bdf;
     uint8_t getRoutingInterval = 0;
+    // New endpoints from routing table registered at the same time
+    unsigned int registrationConcurrency = 8;
 
     ~PcieConfiguration() override;
 };
@@ -0,0 +1,96 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/post.hpp>
+#include <exception>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace mctpd
+{
+
+/**
+ * @brief Stores result of op, so that operations returning different types
+ * can be joined with asyncJoin. result has to outlive the operation.
+ */
+template <typename T>
+boost::asio::awaitable<void> assignResult(boost::asio::awaitable<T> op,
+                                          T& result)
+{
+    result = co_await std::move(op);
+}
+
+/**
+ * @brief Runs ops concurrently on executor and completes once all of them
+ * have finished. Handler signature is void(std::exception_ptr), carrying the
+ * first exception thrown by any of ops.
+ */
+template <typename Executor, typename CompletionToken>
+auto asyncJoin(const Executor& executor,
+               std::vector<boost::asio::awaitable<void>> ops,
+               CompletionToken&& token)
+{
+    return boost::asio::async_initiate<CompletionToken,
+                                       void(std::exception_ptr)>(
+        [executor](auto handler,
+                   std::vector<boost::asio::awaitable<void>> joinedOps) {
+            using Handler = decltype(handler);
+            struct Join
+            {
+                size_t pending;
+                std::exception_ptr error;
+                Handler handler;
+            };
+
+            auto join = std::make_shared<Join>(
+                Join{joinedOps.size(), nullptr, std::move(handler)});
+            auto complete = [executor, join]() {
+                boost::asio::post(executor, [join]() {
+                    std::move(join->handler)(join->error);
+                });
+            };
+
+            if (joinedOps.empty())
+            {
+                complete();
+                return;
+            }
+            for (auto& op : joinedOps)
+            {
+                boost::asio::co_spawn(
+                    executor, std::move(op),
+                    [join, complete](std::exception_ptr error) {
+                        if (error && !join->error)
+                        {
+                            join->error = error;
+                        }
+                        if (--join->pending == 0)
+                        {
+                            complete();
+                        }
+                    });
+            }
+        },
+        token, std::move(ops));
+}
+
+} // namespace mctpd
@@ -0,0 +1,42 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <boost/container/static_vector.hpp>
+#include <cstddef>
+#include <cstdint>
+
+#include "libmctp-nupcie.h"
+#include "libmctp-smbus.h"
+
+namespace mctpd
+{
+
+// Largest binding private data of supported bindings
+inline constexpr size_t maxBindingPrivateSize =
+    std::max(sizeof(mctp_smbus_pkt_private), sizeof(mctp_nupcie_pkt_private));
+
+/**
+ * @brief Binding private data of an endpoint, i.e. raw bytes of binding
+ * pkt_private structure passed to libmctp. Stored inline, so it is copied
+ * into queues and transactions without heap allocation.
+ */
+using BindingPrivate =
+    boost::container::static_vector<uint8_t, maxBindingPrivateSize>;
+
+} // namespace mctpd
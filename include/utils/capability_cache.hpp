@@ -0,0 +1,106 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+#include "utils/ctrl_resp_view.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mctpd
+{
+
+/**
+ * @brief Capabilities of endpoints keyed by their UUID, persisted in a file,
+ * so that they are known right after restart. File starts with magic, format
+ * version, payload size and CRC32 of the payload. File of other version, or
+ * not matching its size or CRC is ignored and rewritten on next store.
+ * Stores are written once no other store came for flushDelay, so that
+ * discovery of many endpoints rewrites the file once. Cache keeps at most
+ * maxEntries, endpoints not stored for the longest time are evicted first.
+ */
+class CapabilityCache
+{
+  public:
+    static constexpr uint32_t magic = 0x4D435043; // "MCPC"
+    static constexpr uint16_t formatVersion = 1;
+    static inline const std::filesystem::path defaultDirectory =
+        "/var/lib/mctpd";
+    static constexpr size_t defaultMaxEntries = 256;
+    static constexpr std::chrono::milliseconds defaultFlushDelay{5000};
+
+    struct Entry
+    {
+        // MCTP control message versions
+        std::vector<MCTPVersionFields> controlVersions;
+        std::vector<uint8_t> msgTypes;
+        // Vendor PCI ID Support
+        std::string vendorIdFormat;
+        std::vector<uint16_t> vendorIdCapabilitySets;
+
+        bool operator==(const Entry&) const = default;
+    };
+
+    explicit CapabilityCache(
+        boost::asio::io_context& ioc, size_t maxEntries = defaultMaxEntries,
+        std::chrono::milliseconds flushDelay = defaultFlushDelay);
+    // Writes pending stores
+    ~CapabilityCache();
+
+    // Loads entries from file, which then keeps every stored entry. Returns
+    // false if file was missing or invalid, cache is empty then.
+    bool load(const std::filesystem::path& file);
+    bool isEnabled() const
+    {
+        return !path.empty();
+    }
+
+    std::optional<Entry> find(const std::string& uuid) const;
+    // Schedules file write only if entry has changed
+    void store(const std::string& uuid, const Entry& entry);
+    // Writes pending stores now
+    void flush();
+
+    static std::vector<uint8_t>
+        serialize(const std::unordered_map<std::string, Entry>& entries);
+    static std::optional<std::unordered_map<std::string, Entry>>
+        deserialize(std::span<const uint8_t> data);
+
+  private:
+    void save() const;
+    void evict();
+
+    boost::asio::steady_timer flushTimer;
+    size_t maxEntries;
+    std::chrono::milliseconds flushDelay;
+    bool dirty = false;
+    std::filesystem::path path;
+    std::unordered_map<std::string, Entry> entries;
+    // Store sequence number of each entry, loaded entries have 0
+    std::unordered_map<std::string, uint64_t> lastStored;
+    uint64_t storeCount = 0;
+};
+
+} // namespace mctpd
@@ -0,0 +1,77 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+#include <libmctp.h>
+
+#include <chrono>
+#include <functional>
+#include <string>
+#include <unordered_map>
+
+namespace mctpd
+{
+
+/**
+ * @brief Stops requests to endpoints which stopped responding. Breaker of
+ * an EID opens after threshold consecutive timeouts and rejects requests
+ * until probe interval passes. Then a single probe request is let through,
+ * its response closes the breaker and its timeout opens it again.
+ */
+class CircuitBreaker
+{
+  public:
+    enum class State : uint8_t
+    {
+        closed,
+        open,
+        halfOpen
+    };
+
+    // 0 threshold disables the breaker
+    void setPolicy(unsigned int threshold,
+                   std::chrono::milliseconds probeInterval);
+
+    // Called with EID and new state whenever state changes
+    using StateObserver = std::function<void(mctp_eid_t, State)>;
+    void setStateObserver(StateObserver observer);
+
+    bool allowRequest(mctp_eid_t eid);
+    void onSuccess(mctp_eid_t eid);
+    void onTimeout(mctp_eid_t eid);
+    void forget(mctp_eid_t eid);
+
+    State getState(mctp_eid_t eid) const;
+    static std::string toString(State state);
+
+  private:
+    struct Endpoint
+    {
+        State state{State::closed};
+        unsigned int timeouts{0};
+        std::chrono::steady_clock::time_point nextProbeAt{};
+    };
+
+    void setState(mctp_eid_t eid, Endpoint& endpoint, State state);
+
+    std::unordered_map<mctp_eid_t, Endpoint> endpoints;
+    unsigned int threshold{5};
+    std::chrono::milliseconds probeInterval{5000};
+    StateObserver stateObserver{};
+};
+
+} // namespace mctpd
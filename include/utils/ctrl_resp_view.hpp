@@ -0,0 +1,112 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+
+#include "libmctp-cmds.h"
+
+struct MCTPVersionFields
+{
+    uint8_t major;
+    uint8_t minor;
+    uint8_t update;
+    uint8_t alpha;
+
+    bool operator==(const MCTPVersionFields&) const = default;
+};
+
+namespace mctpd
+{
+
+/**
+ * @brief Control command response decoded in place. View holds only a span
+ * of the received buffer, which has to outlive it. decode accepts responses
+ * with success completion code and size within given bounds, accessors of
+ * derived views read only bytes checked by their decode.
+ */
+class CtrlRespView
+{
+  public:
+    static std::optional<CtrlRespView>
+        decode(std::span<const uint8_t> resp, size_t minSize,
+               size_t maxSize = std::numeric_limits<size_t>::max());
+
+    uint8_t completionCode() const;
+    std::span<const uint8_t> data() const
+    {
+        return resp;
+    }
+
+  protected:
+    explicit CtrlRespView(std::span<const uint8_t> resp_) : resp(resp_)
+    {
+    }
+
+    // Big endian 16 bit field at given offset
+    uint16_t getBe16(size_t offset) const;
+
+    std::span<const uint8_t> resp;
+};
+
+// Get Message Type Support, list of supported message types
+class MsgTypeSupportView : public CtrlRespView
+{
+  public:
+    static std::optional<MsgTypeSupportView>
+        decode(std::span<const uint8_t> resp);
+
+    std::span<const uint8_t> msgTypes() const;
+
+  private:
+    using CtrlRespView::CtrlRespView;
+};
+
+// Get MCTP Version Support, list of versions of given message type
+class VersionSupportView : public CtrlRespView
+{
+  public:
+    static std::optional<VersionSupportView>
+        decode(std::span<const uint8_t> resp);
+
+    size_t count() const;
+    MCTPVersionFields version(size_t index) const;
+
+  private:
+    using CtrlRespView::CtrlRespView;
+};
+
+// Get Vendor Defined Message Support, one vendor ID set per response
+class VdmSupportView : public CtrlRespView
+{
+  public:
+    static std::optional<VdmSupportView> decode(std::span<const uint8_t> resp);
+
+    uint8_t vendorIdSet() const;
+    uint8_t vendorIdFormat() const;
+    uint16_t vendorIdFormatData() const;
+    uint16_t commandSetType() const;
+
+  private:
+    using CtrlRespView::CtrlRespView;
+};
+
+} // namespace mctpd
@@ -16,23 +16,19 @@
 
 #pragma once
 
+#include "utils/binding_private.hpp"
+
 #include <cstdint>
 #include <numeric>
 #include <unordered_map>
 #include <unordered_set>
-#include <vector>
-
-namespace mctpd
-{
-using BindingPrivateVect = std::vector<uint8_t>;
-}
 
 namespace std
 {
 template <>
-struct hash<mctpd::BindingPrivateVect>
+struct hash<mctpd::BindingPrivate>
 {
-    size_t operator()(const mctpd::BindingPrivateVect& bindingPrivate) const
+    size_t operator()(const mctpd::BindingPrivate& bindingPrivate) const
     {
         size_t init = 0;
         return std::accumulate(std::begin(bindingPrivate),
@@ -50,13 +46,13 @@ struct DeviceWatcher
 {
   public:
     void deviceDiscoveryInit();
-    bool isDeviceGoodForInit(const BindingPrivateVect& bindingPvt);
-    bool checkDeviceInitThreshold(const BindingPrivateVect& bindingPvt);
+    bool isDeviceGoodForInit(const BindingPrivate& bindingPvt);
+    bool checkDeviceInitThreshold(const BindingPrivate& bindingPvt);
 
   private:
-    std::unordered_set<BindingPrivateVect> ignoreList;
-    std::unordered_set<BindingPrivateVect> previousInitList;
-    std::unordered_set<BindingPrivateVect> currentInitList;
-    std::unordered_map<BindingPrivateVect, int> successiveInitCount;
+    std::unordered_set<BindingPrivate> ignoreList;
+    std::unordered_set<BindingPrivate> previousInitList;
+    std::unordered_set<BindingPrivate> currentInitList;
+    std::unordered_map<BindingPrivate, int> successiveInitCount;
 };
 } // namespace mctpd
\ No newline at end of file
@@ -0,0 +1,52 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+#include <libmctp.h>
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+
+namespace mctpd
+{
+
+/**
+ * @brief Tracks control message instance IDs in use per destination EID.
+ * IDs are handed out round robin, so an ID released after timeout is not
+ * reused for the next request and late response cannot complete it.
+ */
+class InstanceIdPool
+{
+  public:
+    static constexpr uint8_t instanceIdCount = 32;
+
+    std::optional<uint8_t> allocate(const mctp_eid_t eid);
+    void release(const mctp_eid_t eid, const uint8_t instanceId);
+    size_t inUse(const mctp_eid_t eid) const;
+
+  private:
+    struct Destination
+    {
+        uint32_t used = 0;
+        uint8_t next = 0;
+    };
+
+    std::unordered_map<mctp_eid_t, Destination> destinations;
+};
+
+} // namespace mctpd
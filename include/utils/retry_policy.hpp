@@ -0,0 +1,60 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+namespace mctpd
+{
+
+// Control commands sharing retry policy
+enum class CtrlCommandClass : uint8_t
+{
+    general,
+    discovery,
+    routingTablePolling,
+    routingInfoUpdate
+};
+
+/**
+ * @brief Response timeout of control request grows by backoff factor after
+ * every attempt, up to max timeout, and is randomized by jitter so requests
+ * sent together do not retry together. Request gives up after retry count
+ * retransmissions or once deadline since first transmission passes.
+ */
+struct RetryPolicy
+{
+    std::chrono::milliseconds timeout{100};
+    uint8_t retryCount{0};
+    unsigned int backoffFactor{1};
+    // 0 means that backoff stops at timeout ceiling
+    std::chrono::milliseconds maxTimeout{0};
+    // Timeout is randomized by +/- jitter percent
+    unsigned int jitterPercent{0};
+    // 0 means that only retry count limits the request
+    std::chrono::milliseconds deadline{0};
+
+    static constexpr std::chrono::milliseconds timeoutCeiling =
+        std::chrono::minutes{1};
+
+    std::chrono::milliseconds getTimeout(unsigned int attempt,
+                                         std::minstd_rand& random) const;
+};
+
+} // namespace mctpd
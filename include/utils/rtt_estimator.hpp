@@ -0,0 +1,66 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+#include <libmctp.h>
+
+#include <chrono>
+#include <optional>
+#include <unordered_map>
+
+namespace mctpd
+{
+
+/**
+ * @brief Smoothed round trip time and its variance per EID, updated the way
+ * RFC 6298 does for TCP. Retransmission timeout is SRTT + 4 * RTTVAR and
+ * doubles on every timeout until next sample arrives. Only responses to
+ * requests sent once are sampled, retransmitted ones are ambiguous.
+ */
+class RttEstimator
+{
+  public:
+    struct Estimate
+    {
+        std::chrono::microseconds smoothedRtt{0};
+        std::chrono::microseconds rttVariance{0};
+        std::chrono::milliseconds timeout{0};
+    };
+
+    void setTimeoutLimits(std::chrono::milliseconds minTimeout,
+                          std::chrono::milliseconds maxTimeout);
+    void addSample(mctp_eid_t eid, std::chrono::microseconds rtt);
+    void addTimeout(mctp_eid_t eid);
+    void forget(mctp_eid_t eid);
+
+    // Empty until first response from eid is sampled
+    std::optional<Estimate> getEstimate(mctp_eid_t eid) const;
+
+  private:
+    struct Endpoint
+    {
+        std::chrono::microseconds smoothedRtt{0};
+        std::chrono::microseconds rttVariance{0};
+        unsigned int backoff{0};
+    };
+
+    std::unordered_map<mctp_eid_t, Endpoint> endpoints;
+    std::chrono::milliseconds minTimeout{10};
+    std::chrono::milliseconds maxTimeout{5000};
+};
+
+} // namespace mctpd
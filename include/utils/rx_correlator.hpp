@@ -0,0 +1,89 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+#include <libmctp.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <span>
+#include <unordered_map>
+
+namespace mctpd
+{
+
+/**
+ * @brief Owns message tags of requests sent by this terminus, for control
+ * and upper layer messages alike, and routes every response to its request
+ * with a single lookup by source EID and tag.
+ */
+class RxCorrelator
+{
+  public:
+    // Returns true when response was consumed by the request
+    using Handler = std::move_only_function<bool(std::span<const uint8_t>)>;
+    // Notified about every tag returned to the pool
+    using ReleaseObserver = std::function<void(mctp_eid_t)>;
+
+    static constexpr uint8_t tagCount = 8;
+
+    std::optional<uint8_t> allocateTag(mctp_eid_t eid);
+    void releaseTag(mctp_eid_t eid, uint8_t tag);
+    bool hasFreeTag(mctp_eid_t eid) const;
+    // Control requests and transmission queue both wait for released tags
+    size_t addReleaseObserver(ReleaseObserver observer);
+    void removeReleaseObserver(size_t id);
+
+    /**
+     * @brief Route responses from eid with given tag to handler. Handler
+     * stays registered until it consumes a response, one shot handler is
+     * removed after first response. Responses to requests sent to null or
+     * broadcast EID are accepted from any source.
+     */
+    void expect(mctp_eid_t eid, uint8_t tag, Handler handler,
+                bool oneShot = false);
+    void forget(mctp_eid_t eid, uint8_t tag);
+
+    bool dispatch(mctp_eid_t srcEid, uint8_t tag,
+                  std::span<const uint8_t> response);
+
+    size_t pendingCount() const;
+
+  private:
+    using Key = uint16_t;
+
+    struct Pending
+    {
+        Handler handler;
+        bool oneShot;
+    };
+
+    static Key getKey(mctp_eid_t eid, uint8_t tag);
+    bool dispatch(Key key, std::span<const uint8_t> response);
+
+    std::array<uint8_t, 256> usedTags{};
+    std::unordered_map<Key, Pending> pending{};
+    // Requests which accept response from any EID, usually none
+    size_t anySourceCount{0};
+    std::map<size_t, ReleaseObserver> releaseObservers{};
+    size_t nextObserverId{0};
+};
+
+} // namespace mctpd
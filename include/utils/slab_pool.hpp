@@ -0,0 +1,92 @@
+/*
+// Copyright (c) 2021 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace mctpd
+{
+
+/**
+ * @brief Free list of equally sized blocks carved from larger slabs. Block
+ * size is fixed by the first allocation, other sizes fall back to the heap.
+ * Memory is kept for reuse until the pool is destroyed.
+ */
+class SlabPool
+{
+  public:
+    explicit SlabPool(size_t blocksPerSlab_ = 32);
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    void* allocate(size_t size, size_t alignment);
+    void deallocate(void* ptr, size_t size, size_t alignment);
+
+    size_t getSlabCount() const;
+
+  private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    void addSlab();
+
+    size_t blockSize{0};
+    size_t blocksPerSlab;
+    FreeBlock* freeList{nullptr};
+    std::vector<std::unique_ptr<std::byte[]>> slabs{};
+};
+
+// Allocator for std::allocate_shared, keeps the pool alive while in use
+template <typename T>
+struct PoolAllocator
+{
+    using value_type = T;
+
+    explicit PoolAllocator(std::shared_ptr<SlabPool> pool_) :
+        pool(std::move(pool_))
+    {
+    }
+
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) : pool(other.pool)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        return static_cast<T*>(pool->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n)
+    {
+        pool->deallocate(ptr, n * sizeof(T), alignof(T));
+    }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const
+    {
+        return pool == other.pool;
+    }
+
+    std::shared_ptr<SlabPool> pool;
+};
+
+} // namespace mctpd
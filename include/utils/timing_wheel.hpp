@@ -0,0 +1,101 @@
+/*
+// Copyright (c) 2021 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#pragma once
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/intrusive/list.hpp>
+#include <array>
+#include <chrono>
+#include <functional>
+#include <optional>
+
+namespace mctpd
+{
+
+/**
+ * @brief Hierarchical timing wheel sharing one asio timer among all entries.
+ * Scheduling and cancellation are O(1), timer is armed only for the nearest
+ * slot holding entries, so nothing runs while no deadline is due.
+ */
+class TimingWheel
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    class Entry
+        : public boost::intrusive::list_base_hook<
+              boost::intrusive::link_mode<boost::intrusive::auto_unlink>>
+    {
+      public:
+        bool isScheduled() const
+        {
+            return is_linked();
+        }
+
+      private:
+        friend class TimingWheel;
+        uint64_t expiryTick{0};
+        uint8_t level{0};
+        uint8_t slot{0};
+    };
+
+    using ExpiryHandler = std::function<void(Entry&)>;
+
+    static constexpr size_t slotBits = 6;
+    static constexpr size_t slotCount = 1 << slotBits;
+    static constexpr size_t levelCount = 3;
+    // Longer timeouts are cascaded again once they get within range
+    static constexpr uint64_t range = uint64_t{1} << (slotBits * levelCount);
+
+    TimingWheel(boost::asio::io_context& ioc, ExpiryHandler handler,
+                std::chrono::milliseconds resolution_ =
+                    std::chrono::milliseconds{1});
+    TimingWheel(const TimingWheel&) = delete;
+    TimingWheel& operator=(const TimingWheel&) = delete;
+
+    void schedule(Entry& entry, Clock::duration timeout);
+    void cancel(Entry& entry);
+
+  private:
+    using Slot = boost::intrusive::list<
+        Entry, boost::intrusive::constant_time_size<false>>;
+
+    struct Level
+    {
+        std::array<Slot, slotCount> slots{};
+        uint64_t occupied{0};
+    };
+
+    uint64_t toTick(Clock::time_point time) const;
+    void insert(Entry& entry);
+    void cascade(size_t level, uint8_t slot, uint64_t tick, Slot& expired);
+    void processTick(uint64_t tick, Slot& expired);
+    std::optional<uint64_t> nextEventTick() const;
+    void advance();
+    void arm();
+
+    boost::asio::steady_timer timer;
+    std::optional<uint64_t> timerTick{};
+    ExpiryHandler onExpiry;
+    std::chrono::milliseconds resolution;
+    Clock::time_point start;
+    uint64_t currentTick{0};
+    std::array<Level, levelCount> levels{};
+};
+
+} // namespace mctpd
@@ -16,12 +16,23 @@
 
 #pragma once
 
+#include "utils/binding_private.hpp"
+#include "utils/rx_correlator.hpp"
+#include "utils/slab_pool.hpp"
+#include "utils/timing_wheel.hpp"
+
 #include <libmctp.h>
 
+#include <boost/asio/async_result.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
 #include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <deque>
+#include <functional>
 #include <map>
 #include <optional>
+#include <span>
 #include <vector>
 
 namespace mctpd
@@ -30,50 +41,276 @@ namespace mctpd
 class MctpTransmissionQueue
 {
   public:
-    struct Message
+    static constexpr std::chrono::steady_clock::time_point noDeadline =
+        std::chrono::steady_clock::time_point::max();
+
+    // Allocated from a slab pool, timeout is tracked by queue timing wheel
+    struct Message : public TimingWheel::Entry
     {
         Message(size_t index_, std::vector<uint8_t>&& payload_,
-                std::vector<uint8_t>&& privateData_,
-                boost::asio::io_context& ioc);
+                const BindingPrivate& privateData_);
 
         size_t index{0};
+        uint8_t priorityClass{0};
+        std::chrono::steady_clock::time_point queuedAt{};
+        // Message still queued at deadline is dropped without transmission
+        std::chrono::steady_clock::time_point deadline{noDeadline};
+        std::chrono::steady_clock::time_point transmittedAt{};
         std::optional<uint8_t> tag;
+        unsigned txAttempts{0};
+        bool txFailed{false};
+        bool shed{false};
         std::vector<uint8_t> payload{};
-        std::vector<uint8_t> privateData{};
-        boost::asio::steady_timer timer;
+        BindingPrivate privateData{};
         std::optional<std::vector<uint8_t>> response{};
+
+      private:
+        friend class MctpTransmissionQueue;
+        std::move_only_function<void(boost::system::error_code)> waiter{};
+        // Needed by response handler, which only holds the message
+        struct mctp* mctp{nullptr};
+        mctp_eid_t destEid{0};
     };
 
-    std::shared_ptr<Message> transmit(struct mctp* mctp, mctp_eid_t destEid,
-                                      std::vector<uint8_t>&& payload,
-                                      std::vector<uint8_t>&& privateData,
-                                      boost::asio::io_context& ioc);
+    struct Statistics
+    {
+        uint64_t transmittedMessages{0};
+        uint64_t transmittedBytes{0};
+        uint64_t rejectedMessages{0};
+        uint64_t failedMessages{0};
+        uint64_t shedMessages{0};
+        size_t queuedMessages{0};
+    };
 
-    bool receive(struct mctp* mctp, mctp_eid_t srcEid, uint8_t msgTag,
-                 std::vector<uint8_t>&& response, boost::asio::io_context& ioc);
+    /**
+     * @brief Message tags are allocated from correlator, which is shared
+     * with control requests sent over the same binding, and responses are
+     * delivered by its dispatch.
+     */
+    explicit MctpTransmissionQueue(
+        boost::asio::io_context& ioc,
+        std::shared_ptr<RxCorrelator> correlator =
+            std::make_shared<RxCorrelator>());
+    ~MctpTransmissionQueue();
 
-    void dispose(mctp_eid_t destEid, const std::shared_ptr<Message>& message);
+    // Transmission credit granted to an endpoint per weight unit on every
+    // scheduling round. Roughly one baseline MCTP packet.
+    static constexpr size_t quantum = 64;
 
-  private:
-    struct Tags
+    /**
+     * @brief Set relative share of the medium given to destination EID when
+     * several endpoints have queued messages. Default weight is 1.
+     */
+    void setWeight(mctp_eid_t destEid, unsigned weight);
+
+    /**
+     * @brief Limit number of messages awaiting response across all
+     * endpoints. 0 means that only per endpoint tag space limits transmission.
+     */
+    void setMaxInFlight(size_t limit);
+
+    /**
+     * @brief Assign priority classes by message type. Types are listed from
+     * the highest priority, unlisted types share the lowest class. Queued
+     * message waiting longer than starvation timeout is served ahead of
+     * higher classes.
+     */
+    void setPriorityClasses(const std::vector<uint8_t>& msgTypes);
+    void setStarvationTimeout(std::chrono::milliseconds timeout);
+
+    /**
+     * @brief Bound number of messages waiting for a tag, per destination EID
+     * and in total. 0 disables given limit.
+     */
+    void setQueueLimits(size_t perEndpoint, size_t total);
+
+    /**
+     * @brief Retry transient mctp_message_tx failures up to count times,
+     * doubling delay after each attempt. Message which cannot be transmitted
+     * is completed with txFailed flag set.
+     */
+    void setRetryPolicy(unsigned count, std::chrono::milliseconds delay);
+    static constexpr std::chrono::milliseconds maxRetryDelay{1000};
+
+    /**
+     * @brief Keep tag of timed out message out of use until late response
+     * arrives or quarantine time passes. 0 returns tag immediately.
+     */
+    void setTagQuarantine(std::chrono::milliseconds quarantine);
+
+    // Returns false when response does not belong to the request
+    using CorrelationHook =
+        std::function<bool(std::span<const uint8_t> request,
+                           std::span<const uint8_t> response)>;
+
+    /**
+     * @brief Additionally verify responses to given message type, on top of
+     * EID and tag matching.
+     */
+    void setCorrelationHook(uint8_t msgType, CorrelationHook hook);
+
+    // Matches PLDM instance ID, type and command of response to request
+    static bool matchPldmInstanceId(std::span<const uint8_t> request,
+                                    std::span<const uint8_t> response);
+
+    // Whole tag space, in-flight window never grows past it
+    static constexpr uint8_t maxWindow = 8;
+
+    /**
+     * @brief Adapt number of messages in flight per destination EID. Window
+     * starts at initial size, grows by one message per window of responses
+     * and halves on every timeout. When disabled, whole tag space is used.
+     */
+    void setAdaptiveWindow(bool enabled, uint8_t initialWindow);
+
+    // Called with destination EID and new window whenever window changes
+    using WindowObserver = std::function<void(mctp_eid_t, uint8_t)>;
+    void setWindowObserver(WindowObserver observer);
+    uint8_t getWindow(mctp_eid_t destEid) const;
+
+    // Called with destination EID and round trip time of every response
+    using RttObserver =
+        std::function<void(mctp_eid_t, std::chrono::microseconds)>;
+    void setRttObserver(RttObserver observer);
+
+    std::map<mctp_eid_t, Statistics> getStatistics() const;
+
+    /**
+     * @brief Queue message for transmission. Within a priority class,
+     * messages are sent in order of their deadlines, earliest first, and
+     * messages without deadline follow in order of arrival. Message whose
+     * deadline passes before it gets a tag is completed with shed flag set
+     * and boost::asio::error::timed_out.
+     *
+     * @return nullptr when queue limit is reached
+     */
+    std::shared_ptr<Message>
+        transmit(struct mctp* mctp, mctp_eid_t destEid,
+                 std::vector<uint8_t>&& payload,
+                 const BindingPrivate& privateData,
+                 std::chrono::steady_clock::time_point deadline = noDeadline);
+
+    // Same as dispatching response through correlator
+    bool receive(mctp_eid_t srcEid, uint8_t msgTag,
+                 std::span<const uint8_t> response);
+
+    // Only timeout of transmitted message shrinks in-flight window, other
+    // disposals are local cancellations. Message disposed while still queued
+    // is counted as shed.
+    void dispose(struct mctp* mctp, mctp_eid_t destEid,
+                 const std::shared_ptr<Message>& message,
+                 bool timedOut = false);
+
+    /**
+     * @brief Wait until message gets response, fails to transmit or timeout
+     * passes. Timeout completes with boost::asio::error::timed_out.
+     */
+    template <typename CompletionToken>
+    auto asyncWait(const std::shared_ptr<Message>& message,
+                   std::chrono::milliseconds timeout, CompletionToken&& token)
     {
-        std::optional<uint8_t> next() const;
-        void emplace(uint8_t flag);
-        void erase(uint8_t flag);
+        return boost::asio::async_initiate<CompletionToken,
+                                           void(boost::system::error_code)>(
+            [this, message, timeout](auto handler) {
+                message->waiter = std::move(handler);
+                if (message->response || message->txFailed)
+                {
+                    complete(*message, {});
+                    return;
+                }
+                if (message->shed)
+                {
+                    complete(*message, boost::asio::error::timed_out);
+                    return;
+                }
+                timingWheel.schedule(*message, timeout);
+            },
+            token);
+    }
 
-        uint8_t bits{0xff};
-    };
+  private:
+    // Ordered by deadline, then by arrival index
+    using MessageKey =
+        std::pair<std::chrono::steady_clock::time_point, size_t>;
+    using MessageQueue = std::map<MessageKey, std::shared_ptr<Message>>;
 
     struct Endpoint
     {
-        Tags availableTags;
-        std::map<uint8_t, std::shared_ptr<Message>> transmittedMessages{};
-        std::map<size_t, std::shared_ptr<Message>> queuedMessages{};
+        // Transmitted messages are kept by correlator until response
+        uint8_t transmittedCount{0};
+        // Keyed by priority class, empty queues are removed
+        std::map<uint8_t, MessageQueue> queuedMessages{};
 
         size_t msgCounter{0u};
-        void transmitQueuedMessages(struct mctp* mctp, mctp_eid_t destEid);
+        size_t queuedCount{0u};
+
+        // Deficit round robin state
+        unsigned weight{1};
+        size_t deficit{0};
+        bool active{false};
+        bool inService{false};
+        std::chrono::steady_clock::time_point retryAt{};
+        std::map<uint8_t, std::chrono::steady_clock::time_point>
+            quarantinedTags{};
+        // Set while every tag is taken, transmission resumes once correlator
+        // releases one of them
+        struct mctp* awaitingTag{nullptr};
+        // Congestion window, unset until endpoint responds or times out
+        std::optional<uint8_t> window{};
+        uint8_t windowResponses{0};
+        Statistics statistics{};
     };
 
+    void activate(mctp_eid_t destEid, Endpoint& endpoint);
+    void enqueue(Endpoint& endpoint, std::shared_ptr<Message> message);
+    bool isBlocked(struct mctp* mctp, mctp_eid_t destEid, Endpoint& endpoint);
+    void scheduleWakeup(struct mctp* mctp,
+                        std::chrono::steady_clock::time_point when);
+    bool inFlightLimitReached() const;
+    void transmitQueuedMessages(struct mctp* mctp);
+    uint8_t getPriorityClass(const std::vector<uint8_t>& payload) const;
+    MessageQueue& selectQueue(Endpoint& endpoint) const;
+    void shedExpiredMessages(Endpoint& endpoint,
+                             std::chrono::steady_clock::time_point now);
+    bool transmitMessage(struct mctp* mctp, mctp_eid_t destEid,
+                         Endpoint& endpoint, MessageQueue& queue);
+    bool onResponse(const std::shared_ptr<Message>& message,
+                    std::span<const uint8_t> response);
+    void complete(Message& message, boost::system::error_code ec);
+    void releaseTag(mctp_eid_t destEid, Endpoint& endpoint, uint8_t msgTag,
+                    bool quarantine = false);
+    uint8_t windowOf(const Endpoint& endpoint) const;
+    void updateWindow(mctp_eid_t destEid, Endpoint& endpoint, bool timedOut);
+    std::optional<std::chrono::steady_clock::time_point>
+        releaseQuarantinedTags(mctp_eid_t destEid, Endpoint& endpoint,
+                               std::chrono::steady_clock::time_point now);
+    void releaseExpiredQuarantines(struct mctp* mctp);
+    void onTagReleased(mctp_eid_t destEid);
+
+    boost::asio::io_context& io;
+    std::shared_ptr<RxCorrelator> correlator;
+    size_t releaseObserverId{0};
+    std::shared_ptr<SlabPool> messagePool;
+    TimingWheel timingWheel;
+    // Resumes transmission after retry backoff or tag quarantine
+    boost::asio::steady_timer wakeupTimer;
+    std::optional<std::chrono::steady_clock::time_point> wakeupTimerExpiry{};
     std::map<mctp_eid_t, Endpoint> endpoints{};
+    std::deque<mctp_eid_t> activeEndpoints{};
+    size_t maxInFlight{0};
+    size_t inFlight{0};
+    size_t maxQueuedPerEndpoint{64};
+    size_t maxQueued{512};
+    size_t queuedCount{0};
+    unsigned retryCount{3};
+    std::chrono::milliseconds retryDelay{10};
+    std::map<uint8_t, uint8_t> priorityClasses{};
+    std::chrono::milliseconds starvationTimeout{1000};
+    std::chrono::milliseconds tagQuarantine{500};
+    std::map<uint8_t, CorrelationHook> correlationHooks{};
+    bool adaptiveWindow{false};
+    uint8_t initialWindow{maxWindow};
+    WindowObserver windowObserver{};
+    RttObserver rttObserver{};
 };
 } // namespace mctpd
\ No newline at end of file
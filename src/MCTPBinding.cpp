@@ -96,7 +96,9 @@ MctpBinding::MctpBinding(std::shared_ptr<sdbusplus::asio::connection> conn,
                          boost::asio::io_context& ioc,
                          const mctp_server::BindingTypes bindingType) :
     MCTPBridge(ioc, objServer),
-    connection(conn), mctpServiceScanner(connection), bindingID(bindingType)
+    connection(conn), transmissionQueue(ioc, correlator),
+    mctpServiceScanner(connection),
+    bindingID(bindingType)
 {
     objServer->add_manager(objPath);
     mctpServiceScanner.setAllowedBuses(conf.allowedBuses.begin(),
@@ -159,6 +161,60 @@ MctpBinding::MctpBinding(std::shared_ptr<sdbusplus::asio::connection> conn,
 
         ctrlTxRetryDelay = conf.reqToRespTime;
         ctrlTxRetryCount = conf.reqRetryCount;
+        ctrlRetryPolicies = conf.ctrlRetryPolicies;
+        adaptiveTimeouts = conf.adaptiveTimeouts;
+        capClientTimeouts = conf.capClientTimeouts;
+        rttEstimator.setTimeoutLimits(
+            std::chrono::milliseconds(conf.adaptiveTimeoutMinMs),
+            std::chrono::milliseconds(conf.adaptiveTimeoutMaxMs));
+
+        for (const auto& [eid, weight] : conf.endpointWeights)
+        {
+            transmissionQueue.setWeight(eid, weight);
+        }
+        transmissionQueue.setMaxInFlight(conf.maxInFlightMessages);
+        transmissionQueue.setPriorityClasses(conf.priorityMessageTypes);
+        transmissionQueue.setStarvationTimeout(
+            std::chrono::milliseconds(conf.starvationTimeoutMs));
+        transmissionQueue.setQueueLimits(conf.maxQueuedMessagesPerEid,
+                                         conf.maxQueuedMessages);
+        transmissionQueue.setRetryPolicy(
+            conf.txRetryCount, std::chrono::milliseconds(conf.txRetryDelayMs));
+        transmissionQueue.setTagQuarantine(
+            std::chrono::milliseconds(conf.tagQuarantineMs));
+        if (conf.matchPldmInstanceId)
+        {
+            transmissionQueue.setCorrelationHook(
+                MCTP_MESSAGE_TYPE_PLDM,
+                mctpd::MctpTransmissionQueue::matchPldmInstanceId);
+        }
+        transmissionQueue.setAdaptiveWindow(conf.adaptiveInFlightWindow,
+                                            conf.initialInFlightWindow);
+        transmissionQueue.setWindowObserver(
+            [this](mctp_eid_t eid, uint8_t window) {
+                auto it = transportInterface.find(eid);
+                if (it != transportInterface.end())
+                {
+                    it->second->set_property("InFlightWindow", window);
+                }
+            });
+        circuitBreaker.setPolicy(
+            conf.circuitBreakerThreshold,
+            std::chrono::milliseconds(conf.circuitBreakerProbeIntervalMs));
+        circuitBreaker.setStateObserver(
+            [this](mctp_eid_t eid, mctpd::CircuitBreaker::State state) {
+                auto it = transportInterface.find(eid);
+                if (it != transportInterface.end())
+                {
+                    it->second->set_property(
+                        "CircuitBreakerState",
+                        mctpd::CircuitBreaker::toString(state));
+                }
+            });
+        transmissionQueue.setRttObserver(
+            [this](mctp_eid_t eid, std::chrono::microseconds rtt) {
+                addRttSample(eid, rtt);
+            });
 
         createUuid();
         registerProperty(mctpInterface, "Eid", ownEid);
@@ -220,7 +276,7 @@ MctpBinding::MctpBinding(std::shared_ptr<sdbusplus::asio::connection> conn,
                             .c_str());
                     return static_cast<int>(mctpErrorRsvBWIsNotActive);
                 }
-                std::optional<std::vector<uint8_t>> pvtData =
+                std::optional<mctpd::BindingPrivate> pvtData =
                     getBindingPrivateData(dstEid);
                 if (!pvtData)
                 {
@@ -273,79 +329,47 @@ MctpBinding::MctpBinding(std::shared_ptr<sdbusplus::asio::connection> conn,
             [this](boost::asio::yield_context yield, uint8_t dstEid,
                    std::vector<uint8_t> payload,
                    uint16_t timeout) -> std::vector<uint8_t> {
-                if (rsvBWActive && dstEid != reservedEID)
-                {
-                    phosphor::logging::log<phosphor::logging::level::WARNING>(
-                        (("SendReceiveMctpMessagePayload is not allowed. "
-                          "ReserveBandwidth is "
-                          "active for EID: ") +
-                         std::to_string(reservedEID))
-                            .c_str());
-                    throw std::system_error(
-                        std::make_error_code(std::errc::invalid_argument));
-                }
+                return sendReceiveMctpMessagePayload(
+                    yield, dstEid, std::move(payload), timeout);
+            });
 
-                if (payload.size() > 0)
-                {
-                    uint8_t msgType = payload[0]; // Always the first byte
-                    if (msgType == MCTP_MESSAGE_TYPE_MCTP_CTRL)
-                    {
-                        phosphor::logging::log<
-                            phosphor::logging::level::WARNING>(
-                            "Transmiting control message");
-                    }
-                }
+        mctpInterface->register_signal<uint8_t, uint8_t, uint8_t, bool,
+                                       std::vector<uint8_t>>(
+            "MessageReceivedSignal");
 
-                std::optional<std::vector<uint8_t>> pvtData =
-                    getBindingPrivateData(dstEid);
-                if (!pvtData)
+        // Returns (EID, messages, bytes, share of transmitted bytes, current
+        // queue depth, rejected messages, messages shed at deadline) for each
+        // endpoint served by SendReceiveMctpMessagePayload
+        mctpInterface->register_method(
+            "GetTransmissionStatistics",
+            [this]()
+                -> std::vector<std::tuple<uint8_t, uint64_t, uint64_t, double,
+                                          uint32_t, uint64_t, uint64_t>> {
+                const auto statistics = transmissionQueue.getStatistics();
+                uint64_t totalBytes = 0;
+                for (const auto& [eid, stats] : statistics)
                 {
-                    phosphor::logging::log<phosphor::logging::level::ERR>(
-                        "SendReceiveMctpMessagePayload: Invalid destination "
-                        "EID");
-                    throw std::system_error(
-                        std::make_error_code(std::errc::invalid_argument));
+                    totalBytes += stats.transmittedBytes;
                 }
 
-                boost::system::error_code ec;
-                auto message =
-                    transmissionQueue.transmit(mctp, dstEid, std::move(payload),
-                                               std::move(pvtData).value(), io);
-
-                message->timer.expires_after(
-                    std::chrono::milliseconds(timeout));
-                message->timer.async_wait(yield[ec]);
-
-                if (ec && ec != boost::asio::error::operation_aborted)
-                {
-                    transmissionQueue.dispose(dstEid, message);
-                    phosphor::logging::log<phosphor::logging::level::ERR>(
-                        "Timer failed");
-                    throw std::system_error(
-                        std::make_error_code(std::errc::connection_aborted));
-                }
-                if (!message->response)
-                {
-                    transmissionQueue.dispose(dstEid, message);
-                    phosphor::logging::log<phosphor::logging::level::ERR>(
-                        "No response");
-                    throw std::system_error(
-                        std::make_error_code(std::errc::timed_out));
-                }
-                if (message->response->empty())
+                std::vector<std::tuple<uint8_t, uint64_t, uint64_t, double,
+                                       uint32_t, uint64_t, uint64_t>>
+                    result;
+                for (const auto& [eid, stats] : statistics)
                 {
-                    phosphor::logging::log<phosphor::logging::level::ERR>(
-                        "Empty response");
-                    throw std::system_error(
-                        std::make_error_code(std::errc::no_message_available));
+                    const double share =
+                        totalBytes == 0
+                            ? 0.0
+                            : static_cast<double>(stats.transmittedBytes) /
+                                  static_cast<double>(totalBytes);
+                    result.emplace_back(
+                        eid, stats.transmittedMessages, stats.transmittedBytes,
+                        share, static_cast<uint32_t>(stats.queuedMessages),
+                        stats.rejectedMessages, stats.shedMessages);
                 }
-                return std::move(message->response).value();
+                return result;
             });
 
-        mctpInterface->register_signal<uint8_t, uint8_t, uint8_t, bool,
-                                       std::vector<uint8_t>>(
-            "MessageReceivedSignal");
-
         mctpInterface->register_method(
             "RegisterResponder",
             [this](uint8_t msgTypeName,
@@ -406,9 +430,6 @@ void MctpBinding::rxMessage(uint8_t srcEid, void* data, void* msg, size_t len,
 
     uint8_t* payload = reinterpret_cast<uint8_t*>(msg);
     uint8_t msgType = payload[0]; // Always the first byte
-    std::vector<uint8_t> response;
-
-    response.assign(payload, payload + len);
 
     auto& binding = *static_cast<MctpBinding*>(data);
 
@@ -417,25 +438,15 @@ void MctpBinding::rxMessage(uint8_t srcEid, void* data, void* msg, size_t len,
         binding.addUnknownEIDToDeviceTable(srcEid, bindingPrivate);
     }
 
-    // TODO: Take into account the msgTags too when we verify control messages.
-    if (!tagOwner && mctp_is_mctp_ctrl_msg(msg, len) &&
-        !mctp_ctrl_msg_is_req(msg, len))
-    {
-        phosphor::logging::log<phosphor::logging::level::DEBUG>(
-            "MCTP Control packet response received!!");
-        if (binding.handleCtrlResp(msg, len))
-        {
-            return;
-        }
-    }
-
-    if (!tagOwner &&
-        binding.transmissionQueue.receive(binding.mctp, srcEid, msgTag,
-                                          std::move(response), binding.io))
+    // Responses to control and upper layer requests alike are matched by
+    // correlator, payload is copied only once it gets to the request
+    const std::span<const uint8_t> received(payload, len);
+    if (!tagOwner && binding.correlator->dispatch(srcEid, msgTag, received))
     {
         return;
     }
 
+    std::vector<uint8_t> response(payload, payload + len);
     auto msgSignal = binding.connection->new_signal("/xyz/openbmc_project/mctp",
                                                     mctp_server::interface,
                                                     "MessageReceivedSignal");
@@ -617,18 +628,18 @@ bool MctpBinding::setMediumId(
 
 /* This api provides option to register an endpoint using the binding
  * private data. The callers of this api can parallelize multiple
- * endpoint registrations by spawning coroutines and passing yield contexts.*/
+ * endpoint registrations by co_spawning them, each registration keeps only
+ * its coroutine frame instead of a separate stack.*/
 
-std::optional<mctp_eid_t>
-    MctpBinding::registerEndpoint(boost::asio::yield_context& yield,
-                                  const std::vector<uint8_t>& bindingPrivate,
+boost::asio::awaitable<std::optional<mctp_eid_t>>
+    MctpBinding::registerEndpoint(const mctpd::BindingPrivate& bindingPrivate,
                                   mctp_eid_t eid,
                                   mctp_server::BindingModeTypes bindingMode)
 {
     if (bindingModeType == mctp_server::BindingModeTypes::BusOwner)
     {
         std::optional<mctp_eid_t> destEID =
-            busOwnerRegisterEndpoint(yield, bindingPrivate, eid);
+            co_await busOwnerRegisterEndpoint(bindingPrivate, eid);
 
         // Handle the device if removed and the device reset due to Frimware
         // update/hot plugged.
@@ -636,16 +647,17 @@ std::optional<mctp_eid_t>
         {
             clearRegisteredDevice(eid);
         }
-        return destEID;
+        co_return destEID;
     }
 
-    MsgTypeSupportCtrlResp msgTypeSupportResp;
-    if (!(getMsgTypeSupportCtrlCmd(yield, bindingPrivate, eid,
-                                   &msgTypeSupportResp)))
+    std::vector<uint8_t> msgTypeSupportResp;
+    auto msgTypeSupport = co_await getMsgTypeSupportCtrlCmd(bindingPrivate, eid,
+                                                            msgTypeSupportResp);
+    if (!msgTypeSupport)
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get Message Type Support failed");
-        return std::nullopt;
+        co_return std::nullopt;
     }
 
     // check if EID is already registered
@@ -653,13 +665,13 @@ std::optional<mctp_eid_t>
     {
         phosphor::logging::log<phosphor::logging::level::WARNING>(
             ("EID " + std::to_string(eid) + " is already registered").c_str());
-        return std::nullopt;
+        co_return std::nullopt;
     }
 
     EndpointProperties epProperties;
     std::vector<uint8_t> getUuidResp;
 
-    if (!(getUuidCtrlCmd(yield, bindingPrivate, eid, getUuidResp)))
+    if (!(co_await getUuidCtrlCmd(bindingPrivate, eid, getUuidResp)))
     {
         /* In case EP doesn't support Get UUID set to all 0 */
         phosphor::logging::log<phosphor::logging::level::ERR>(
@@ -677,9 +689,9 @@ std::optional<mctp_eid_t>
     epProperties.mode = bindingMode;
     // TODO:get Network ID, now set it to 0
     epProperties.networkId = 0x00;
-    epProperties.endpointMsgTypes = getMsgTypes(msgTypeSupportResp.msgType);
+    epProperties.endpointMsgTypes = getMsgTypes(msgTypeSupport->msgTypes());
 
-    getVendorDefinedMessageTypes(yield, bindingPrivate, eid, epProperties);
+    co_await getVendorDefinedMessageTypes(bindingPrivate, eid, epProperties);
 
     phosphor::logging::log<phosphor::logging::level::INFO>(
         ("Device Registered: EID = " + std::to_string(eid)).c_str());
@@ -703,7 +715,27 @@ std::optional<mctp_eid_t>
     populateDeviceProperties(eid, bindingPrivate);
     populateEndpointProperties(epProperties);
 
-    return eid;
+    co_return eid;
+}
+
+void MctpBinding::populateTransportProperties(
+    std::shared_ptr<dbus_interface>& transportIntf, const mctp_eid_t eid)
+{
+    registerProperty(transportIntf, "InFlightWindow",
+                     transmissionQueue.getWindow(eid));
+
+    // Zero until endpoint answers first request
+    const auto estimate =
+        rttEstimator.getEstimate(eid).value_or(mctpd::RttEstimator::Estimate{});
+    registerProperty(transportIntf, "SmoothedRoundTripTimeUs",
+                     static_cast<uint64_t>(estimate.smoothedRtt.count()));
+    registerProperty(transportIntf, "RoundTripTimeVarianceUs",
+                     static_cast<uint64_t>(estimate.rttVariance.count()));
+    registerProperty(transportIntf, "RetransmissionTimeoutMs",
+                     static_cast<uint64_t>(estimate.timeout.count()));
+    registerProperty(
+        transportIntf, "CircuitBreakerState",
+        mctpd::CircuitBreaker::toString(circuitBreaker.getState(eid)));
 }
 
 void MctpBinding::clearRegisteredDevice(const mctp_eid_t eid)
@@ -718,6 +750,119 @@ void MctpBinding::clearRegisteredDevice(const mctp_eid_t eid)
     }
 }
 
+std::vector<uint8_t> MctpBinding::sendReceiveMctpMessagePayload(
+    boost::asio::yield_context yield, uint8_t dstEid,
+    std::vector<uint8_t> payload, uint16_t timeout)
+{
+    if (rsvBWActive && dstEid != reservedEID)
+    {
+        phosphor::logging::log<phosphor::logging::level::WARNING>(
+            (("SendReceiveMctpMessagePayload is not allowed. "
+              "ReserveBandwidth is "
+              "active for EID: ") +
+             std::to_string(reservedEID))
+                .c_str());
+        throw std::system_error(
+            std::make_error_code(std::errc::invalid_argument));
+    }
+
+    if (payload.size() > 0)
+    {
+        uint8_t msgType = payload[0]; // Always the first byte
+        if (msgType == MCTP_MESSAGE_TYPE_MCTP_CTRL)
+        {
+            phosphor::logging::log<phosphor::logging::level::WARNING>(
+                "Transmiting control message");
+        }
+    }
+
+    std::optional<mctpd::BindingPrivate> pvtData =
+        getBindingPrivateData(dstEid);
+    if (!pvtData)
+    {
+        phosphor::logging::log<phosphor::logging::level::ERR>(
+            "SendReceiveMctpMessagePayload: Invalid destination EID");
+        throw std::system_error(
+            std::make_error_code(std::errc::invalid_argument));
+    }
+
+    if (!circuitBreaker.allowRequest(dstEid))
+    {
+        phosphor::logging::log<phosphor::logging::level::WARNING>(
+            "SendReceiveMctpMessagePayload: Endpoint is not responding, "
+            "circuit breaker is open",
+            phosphor::logging::entry("EID=%d", dstEid));
+        throw std::system_error(
+            std::make_error_code(std::errc::host_unreachable));
+    }
+
+    std::chrono::milliseconds responseTimeout(timeout);
+    if (capClientTimeouts)
+    {
+        if (auto estimate = rttEstimator.getEstimate(dstEid))
+        {
+            responseTimeout = std::min(responseTimeout, estimate->timeout);
+        }
+    }
+
+    // Caller gives up after its timeout, no point in sending the request once
+    // that passes
+    const auto deadline = std::chrono::steady_clock::now() + responseTimeout;
+    boost::system::error_code ec;
+    auto message = transmissionQueue.transmit(
+        mctp, dstEid, std::move(payload), pvtData.value(), deadline);
+    if (!message)
+    {
+        phosphor::logging::log<phosphor::logging::level::WARNING>(
+            "SendReceiveMctpMessagePayload: Transmission queue full",
+            phosphor::logging::entry("EID=%d", dstEid));
+        throw std::system_error(
+            std::make_error_code(std::errc::no_buffer_space));
+    }
+
+    transmissionQueue.asyncWait(message, responseTimeout, yield[ec]);
+
+    if (message->txFailed)
+    {
+        phosphor::logging::log<phosphor::logging::level::ERR>(
+            "SendReceiveMctpMessagePayload: Transmission failed",
+            phosphor::logging::entry("EID=%d", dstEid));
+        throw std::system_error(std::make_error_code(std::errc::io_error));
+    }
+
+    if (ec && ec != boost::asio::error::timed_out)
+    {
+        transmissionQueue.dispose(mctp, dstEid, message);
+        phosphor::logging::log<phosphor::logging::level::ERR>("Timer failed");
+        throw std::system_error(
+            std::make_error_code(std::errc::connection_aborted));
+    }
+    if (!message->response)
+    {
+        // Only timeouts of transmitted messages say anything about the
+        // endpoint
+        if (message->tag)
+        {
+            addRttTimeout(dstEid);
+            circuitBreaker.onTimeout(dstEid);
+        }
+        transmissionQueue.dispose(mctp, dstEid, message, true);
+        phosphor::logging::log<phosphor::logging::level::ERR>(
+            message->shed ? "Deadline passed before transmission"
+                          : "No response",
+            phosphor::logging::entry("EID=%d", dstEid));
+        throw std::system_error(std::make_error_code(std::errc::timed_out));
+    }
+    circuitBreaker.onSuccess(dstEid);
+    if (message->response->empty())
+    {
+        phosphor::logging::log<phosphor::logging::level::ERR>("Empty response");
+        throw std::system_error(
+            std::make_error_code(std::errc::no_message_available));
+    }
+    return std::move(message->response).value();
+}
+
 void MctpBinding::addUnknownEIDToDeviceTable(const mctp_eid_t, void*)
 {
     // Do nothing
@@ -766,7 +911,7 @@ MctpStatus MctpBinding::sendMctpRawPayload(const std::vector<uint8_t>& payload)
                         .c_str());
             }
 
-            std::optional<std::vector<uint8_t>> pvtData =
+            std::optional<mctpd::BindingPrivate> pvtData =
                 getBindingPrivateData(dstEid);
             if (!pvtData)
             {
@@ -1,5 +1,8 @@
 #include "PCIeBinding.hpp"
 
+#include "utils/async_join.hpp"
+
+#include <boost/asio/use_awaitable.hpp>
 #include <phosphor-logging/log.hpp>
 
 PCIeBinding::~PCIeBinding()
@@ -16,6 +19,7 @@ PCIeBinding::PCIeBinding(std::shared_ptr<sdbusplus::asio::connection> conn,
                          std::shared_ptr<hw::DeviceMonitor>&& hwMonitorParam) :
     MctpBinding(conn, objServer, objPath, conf, ioc,
                 mctp_server::BindingTypes::MctpOverPcieVdm),
+    registrationConcurrency(std::max(conf.registrationConcurrency, 1u)),
     hw{std::move(hwParam)}, hwMonitor{std::move(hwMonitorParam)},
     getRoutingInterval(conf.getRoutingInterval),
     getRoutingTableTimer(ioc, getRoutingInterval)
@@ -63,17 +67,20 @@ void PCIeBinding::endpointDiscoveryFlow()
     pktPrv.routing = PCIE_ROUTE_TO_RC;
     pktPrv.remote_id = bdf;
     uint8_t* pktPrvPtr = reinterpret_cast<uint8_t*>(&pktPrv);
-    std::vector<uint8_t> prvData =
-        std::vector<uint8_t>(pktPrvPtr, pktPrvPtr + sizeof pktPrv);
+    mctpd::BindingPrivate prvData =
+        mctpd::BindingPrivate(pktPrvPtr, pktPrvPtr + sizeof pktPrv);
     changeDiscoveredFlag(pcie_binding::DiscoveryFlags::Undiscovered);
 
-    boost::asio::spawn(io, [prvData, this](boost::asio::yield_context yield) {
-        if (!discoveryNotifyCtrlCmd(yield, prvData, MCTP_EID_NULL))
-        {
-            phosphor::logging::log<phosphor::logging::level::ERR>(
-                "Discovery Notify failed");
-        }
-    }, boost::asio::detached);
+    boost::asio::co_spawn(
+        io,
+        [prvData, this]() -> boost::asio::awaitable<void> {
+            if (!co_await discoveryNotifyCtrlCmd(prvData, MCTP_EID_NULL))
+            {
+                phosphor::logging::log<phosphor::logging::level::ERR>(
+                    "Discovery Notify failed");
+            }
+        },
+        boost::asio::detached);
 }
 
 mctp_server::BindingModeTypes
@@ -165,11 +172,11 @@ bool PCIeBinding::isBridgeCalled(
                         }) != calledBridges.end();
 }
 
-void PCIeBinding::readRoutingTable(
+boost::asio::awaitable<void> PCIeBinding::readRoutingTable(
     std::vector<routingTableEntry_t>& rt,
     std::vector<calledBridgeEntry_t>& calledBridges,
-    std::vector<uint8_t> prvData, boost::asio::yield_context& yield,
-    uint8_t eid, uint16_t physAddr, long entryIndex)
+    mctpd::BindingPrivate prvData, uint8_t eid, uint16_t physAddr,
+    long entryIndex)
 {
     std::vector<uint8_t> getRoutingTableEntryResp = {};
     uint8_t entryHandle = 0x00;
@@ -180,12 +187,12 @@ void PCIeBinding::readRoutingTable(
     {
         calledBridges.push_back(std::make_tuple(eid, physAddr));
 
-        if (!getRoutingTableCtrlCmd(yield, prvData, eid, entryHandle,
-                                    getRoutingTableEntryResp))
+        if (!co_await getRoutingTableCtrlCmd(prvData, eid, entryHandle,
+                                             getRoutingTableEntryResp))
         {
             phosphor::logging::log<phosphor::logging::level::ERR>(
                 "Get Routing Table failed");
-            return;
+            co_return;
         }
 
         auto routingTableHdr =
@@ -240,10 +247,9 @@ void PCIeBinding::readRoutingTable(
     }
 }
 
-void PCIeBinding::processBridgeEntries(
+boost::asio::awaitable<void> PCIeBinding::processBridgeEntries(
     std::vector<routingTableEntry_t>& rt,
-    std::vector<calledBridgeEntry_t>& calledBridges,
-    boost::asio::yield_context& yield)
+    std::vector<calledBridgeEntry_t>& calledBridges)
 {
     std::vector<routingTableEntry_t> rtCopy = rt;
 
@@ -256,12 +262,13 @@ void PCIeBinding::processBridgeEntries(
         pktPrv.routing = PCIE_ROUTE_BY_ID;
         pktPrv.remote_id = std::get<1>(*entry);
         uint8_t* pktPrvPtr = reinterpret_cast<uint8_t*>(&pktPrv);
-        std::vector<uint8_t> prvData = std::vector<uint8_t>(
+        mctpd::BindingPrivate prvData = mctpd::BindingPrivate(
             pktPrvPtr, pktPrvPtr + sizeof(mctp_nupcie_pkt_private));
 
         long entryIndex = std::distance(rt.begin(), entry);
-        readRoutingTable(rtCopy, calledBridges, prvData, yield,
-                         std::get<0>(*entry), std::get<1>(*entry), entryIndex);
+        co_await readRoutingTable(rtCopy, calledBridges, prvData,
+                                  std::get<0>(*entry), std::get<1>(*entry),
+                                  entryIndex);
     }
     rt = rtCopy;
 }
@@ -282,38 +289,46 @@ void PCIeBinding::updateRoutingTable()
     pktPrv.routing = PCIE_ROUTE_BY_ID;
     pktPrv.remote_id = busOwnerBdf;
     uint8_t* pktPrvPtr = reinterpret_cast<uint8_t*>(&pktPrv);
-    std::vector<uint8_t> prvData = std::vector<uint8_t>(
+    mctpd::BindingPrivate prvData = mctpd::BindingPrivate(
         pktPrvPtr, pktPrvPtr + sizeof(mctp_nupcie_pkt_private));
 
-    boost::asio::spawn(io, [prvData, this](boost::asio::yield_context yield) {
-        std::vector<routingTableEntry_t> routingTableTmp;
-        std::vector<calledBridgeEntry_t> calledBridges;
+    boost::asio::co_spawn(
+        io,
+        [prvData, this]() -> boost::asio::awaitable<void> {
+            std::vector<routingTableEntry_t> routingTableTmp;
+            std::vector<calledBridgeEntry_t> calledBridges;
 
-        readRoutingTable(routingTableTmp, calledBridges, prvData, yield,
-                         busOwnerEid, busOwnerBdf);
+            co_await readRoutingTable(routingTableTmp, calledBridges, prvData,
+                                      busOwnerEid, busOwnerBdf);
 
-        while (!allBridgesCalled(routingTableTmp, calledBridges))
-        {
-            processBridgeEntries(routingTableTmp, calledBridges, yield);
-        }
+            while (!allBridgesCalled(routingTableTmp, calledBridges))
+            {
+                co_await processBridgeEntries(routingTableTmp, calledBridges);
+            }
 
-        if (routingTableTmp != routingTable)
-        {
-	    //nu todo
-            //if (!setDriverEndpointMap(routingTableTmp))
-            //{
-            //    phosphor::logging::log<phosphor::logging::level::ERR>(
-            //        "Failed to store routing table in KMD");
-            //}
-
-            processRoutingTableChanges(routingTableTmp, yield, prvData);
-            routingTable = routingTableTmp;
-        }
-    }, boost::asio::detached);
+            if (routingTableTmp != routingTable)
+            {
+	        //nu todo
+                //if (!setDriverEndpointMap(routingTableTmp))
+                //{
+                //    phosphor::logging::log<phosphor::logging::level::ERR>(
+                //        "Failed to store routing table in KMD");
+                //}
+
+                co_await processRoutingTableChanges(routingTableTmp, prvData);
+                routingTable = routingTableTmp;
+            }
+        },
+        boost::asio::detached);
+}
+
+bool PCIeBinding::isPipelinedRegistrationAllowed(const mctpd::BindingPrivate&)
+{
+    return true;
 }
 
 void PCIeBinding::populateDeviceProperties(
-    const mctp_eid_t eid, const std::vector<uint8_t>& bindingPrivate)
+    const mctp_eid_t eid, const mctpd::BindingPrivate& bindingPrivate)
 {
     auto pcieBindingPvt = reinterpret_cast<const mctp_nupcie_pkt_private*>(
         bindingPrivate.data());
@@ -339,9 +354,9 @@ void PCIeBinding::populateDeviceProperties(
 /* Function takes new routing table, detect changes and creates or removes
  * device interfaces on dbus.
  */
-void PCIeBinding::processRoutingTableChanges(
+boost::asio::awaitable<void> PCIeBinding::processRoutingTableChanges(
     const std::vector<routingTableEntry_t>& newTable,
-    boost::asio::yield_context& yield, const std::vector<uint8_t>& prvData)
+    const mctpd::BindingPrivate& prvData)
 {
     struct mctp_nupcie_pkt_private pktPrv;
     memcpy(&pktPrv, prvData.data(), sizeof(pktPrv));
@@ -363,46 +378,75 @@ void PCIeBinding::processRoutingTableChanges(
      * routing table but not present in the routing table stored as
      * the class member, register new dbus device interface
      */
+    std::deque<routingTableEntry_t> newEndpoints;
     for (auto& routingEntry : newTable)
     {
         if (find(routingTable.begin(), routingTable.end(), routingEntry) ==
-            routingTable.end())
+                routingTable.end() &&
+            std::get<0>(routingEntry) != ownEid)
         {
-            mctp_eid_t remoteEid = std::get<0>(routingEntry);
+            newEndpoints.push_back(routingEntry);
+        }
+    }
 
-            if (remoteEid == ownEid)
-            {
-                continue;
-            }
+    /* PCIe VDM has no single request restriction like SMBus mux, so new
+     * endpoints are registered concurrently. Each worker takes the next
+     * endpoint once registration of the previous one completes.
+     */
+    const size_t workerCount =
+        std::min(registrationConcurrency, newEndpoints.size());
+    std::vector<boost::asio::awaitable<void>> workers;
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        workers.push_back(registerEndpoints(newEndpoints, prvData));
+    }
+    co_await mctpd::asyncJoin(io.get_executor(), std::move(workers),
+                              boost::asio::use_awaitable);
+}
 
-            std::vector<uint8_t> prvDataCopy = prvData;
-            mctp_nupcie_pkt_private* pciePrivate =
-                reinterpret_cast<mctp_nupcie_pkt_private*>(prvDataCopy.data());
-            pciePrivate->remote_id = std::get<1>(routingEntry);
-            registerEndpoint(yield, prvDataCopy, remoteEid,
-                             getBindingMode(routingEntry));
-
-            /* Log the device info:
-             * Bus - 8 bits, Device - 5 bits, Function - 3 bits
-             */
-            std::stringstream busHex, deviceHex, functionHex;
-            busHex << std::setfill('0') << std::setw(2) << std::hex
-                   << hw::bdf::getBus(pciePrivate->remote_id);
-            deviceHex << std::setfill('0') << std::setw(2) << std::hex
-                      << hw::bdf::getDevice(pciePrivate->remote_id);
-            functionHex << std::hex
-                        << hw::bdf::getFunction(pciePrivate->remote_id);
-
-            std::string bus(busHex.str()), device(deviceHex.str()),
-                function(functionHex.str());
-
-            phosphor::logging::log<phosphor::logging::level::INFO>(
-                ("PCIe device " + bus + ":" + device + "." + function +
-                 " registered at EID " + std::to_string(remoteEid))
-                    .c_str());
-        }
+boost::asio::awaitable<void>
+    PCIeBinding::registerEndpoints(std::deque<routingTableEntry_t>& pending,
+                                   const mctpd::BindingPrivate& prvData)
+{
+    while (!pending.empty())
+    {
+        const routingTableEntry_t routingEntry = pending.front();
+        pending.pop_front();
+        co_await registerRoutingEntry(routingEntry, prvData);
     }
 }
+
+boost::asio::awaitable<void>
+    PCIeBinding::registerRoutingEntry(const routingTableEntry_t& routingEntry,
+                                      const mctpd::BindingPrivate& prvData)
+{
+    mctp_eid_t remoteEid = std::get<0>(routingEntry);
+
+    mctpd::BindingPrivate prvDataCopy = prvData;
+    mctp_nupcie_pkt_private* pciePrivate =
+        reinterpret_cast<mctp_nupcie_pkt_private*>(prvDataCopy.data());
+    pciePrivate->remote_id = std::get<1>(routingEntry);
+    co_await registerEndpoint(prvDataCopy, remoteEid,
+                              getBindingMode(routingEntry));
+
+    /* Log the device info:
+     * Bus - 8 bits, Device - 5 bits, Function - 3 bits
+     */
+    std::stringstream busHex, deviceHex, functionHex;
+    busHex << std::setfill('0') << std::setw(2) << std::hex
+           << hw::bdf::getBus(pciePrivate->remote_id);
+    deviceHex << std::setfill('0') << std::setw(2) << std::hex
+              << hw::bdf::getDevice(pciePrivate->remote_id);
+    functionHex << std::hex << hw::bdf::getFunction(pciePrivate->remote_id);
+
+    std::string bus(busHex.str()), device(deviceHex.str()),
+        function(functionHex.str());
+
+    phosphor::logging::log<phosphor::logging::level::INFO>(
+        ("PCIe device " + bus + ":" + device + "." + function +
+         " registered at EID " + std::to_string(remoteEid))
+            .c_str());
+}
 //nu todo
 #if 0
 bool PCIeBinding::setDriverEndpointMap(
@@ -714,7 +758,7 @@ void PCIeBinding::deviceReadyNotify(bool ready)
     pcieInterface->set_property("BDF", bdf);
 }
 
-std::optional<std::vector<uint8_t>>
+std::optional<mctpd::BindingPrivate>
     PCIeBinding::getBindingPrivateData(uint8_t dstEid)
 {
     mctp_nupcie_pkt_private pktPrv = {};
@@ -734,7 +778,7 @@ std::optional<std::vector<uint8_t>>
     const auto& [eid, endpointBdf, entryType] = *it;
     pktPrv.remote_id = endpointBdf;
     uint8_t* pktPrvPtr = reinterpret_cast<uint8_t*>(&pktPrv);
-    return std::vector<uint8_t>(pktPrvPtr, pktPrvPtr + sizeof(pktPrv));
+    return mctpd::BindingPrivate(pktPrvPtr, pktPrvPtr + sizeof(pktPrv));
 }
 
 void PCIeBinding::changeDiscoveredFlag(pcie_binding::DiscoveryFlags flag)
@@ -241,7 +241,7 @@ int SMBusBinding::getBusNumByFd(const int fd)
     return -1;
 }
 
-std::optional<std::vector<uint8_t>>
+std::optional<mctpd::BindingPrivate>
     SMBusBinding::getBindingPrivateData(uint8_t dstEid)
 {
     mctp_smbus_pkt_private prvt = {};
@@ -264,7 +264,7 @@ std::optional<std::vector<uint8_t>>
             }
             prvt.slave_addr = temp.slave_addr;
             uint8_t* prvtPtr = reinterpret_cast<uint8_t*>(&prvt);
-            return std::vector<uint8_t>(prvtPtr, prvtPtr + sizeof(prvt));
+            return mctpd::BindingPrivate(prvtPtr, prvtPtr + sizeof(prvt));
         }
     }
     return std::nullopt;
@@ -282,7 +282,7 @@ bool SMBusBinding::reserveBandwidth(const mctp_eid_t eid,
                 .c_str());
         return false;
     }
-    std::optional<std::vector<uint8_t>> pvtData = getBindingPrivateData(eid);
+    std::optional<mctpd::BindingPrivate> pvtData = getBindingPrivateData(eid);
     if (!pvtData)
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
@@ -388,6 +388,7 @@ SMBusBinding::SMBusBinding(
         bmcSlaveAddr = conf.bmcSlaveAddr;
         supportedEndpointSlaveAddress = conf.supportedEndpointSlaveAddress;
         scanInterval = conf.scanInterval;
+        incrementalRediscovery = conf.incrementalRediscovery;
 
         // TODO: If we are not top most busowner, wait for top mostbus owner
         // to issue EID Pool
@@ -438,11 +439,11 @@ void SMBusBinding::scanDevices()
 {
     phosphor::logging::log<phosphor::logging::level::DEBUG>("Scanning devices");
 
-    boost::asio::spawn(io, [this](boost::asio::yield_context yield) {
+    boost::asio::co_spawn(io, [this]() -> boost::asio::awaitable<void> {
         if (!rsvBWActive)
         {
             deviceWatcher.deviceDiscoveryInit();
-            initEndpointDiscovery(yield);
+            co_await initEndpointDiscovery();
         }
         else
         {
@@ -695,7 +696,11 @@ SMBusBinding::~SMBusBinding()
     {
         close(outFd);
     }
-    mctp_smbus_free(smbus);
+    // Binding is not initialized if initializeBinding failed
+    if (smbus != nullptr)
+    {
+        mctp_smbus_free(smbus);
+    }
     objectServer->remove_interface(smbusInterface);
 }
 
@@ -810,7 +815,7 @@ void SMBusBinding::scanMuxBus(std::set<std::pair<int, uint8_t>>& deviceMap)
 }
 
 std::optional<std::string>
-    SMBusBinding::getLocationCode(const std::vector<uint8_t>& bindingPrivate)
+    SMBusBinding::getLocationCode(const mctpd::BindingPrivate& bindingPrivate)
 {
     const std::filesystem::path muxSymlinkDirPath("/dev/i2c-mux");
     auto smbusBindingPvt =
@@ -851,7 +856,7 @@ std::optional<std::string>
 }
 
 void SMBusBinding::populateDeviceProperties(
-    const mctp_eid_t eid, const std::vector<uint8_t>& bindingPrivate)
+    const mctp_eid_t eid, const mctpd::BindingPrivate& bindingPrivate)
 {
     auto smbusBindingPvt =
         reinterpret_cast<const mctp_smbus_pkt_private*>(bindingPrivate.data());
@@ -870,7 +875,7 @@ void SMBusBinding::populateDeviceProperties(
     deviceInterface.emplace(eid, std::move(smbusIntf));
 }
 
-void SMBusBinding::initEndpointDiscovery(boost::asio::yield_context& yield)
+boost::asio::awaitable<void> SMBusBinding::initEndpointDiscovery()
 {
     std::set<std::pair<int, uint8_t>> registerDeviceMap;
 
@@ -887,9 +892,30 @@ void SMBusBinding::initEndpointDiscovery(boost::asio::yield_context& yield)
     // all the mux ports
     scanMuxBus(registerDeviceMap);
 
+    co_await registerDevices(registerDeviceMap);
+
+    // Add to check root device
+    if (registerDeviceMap.empty() && rootDeviceMap.empty())
+    {
+        phosphor::logging::log<phosphor::logging::level::DEBUG>(
+            "No device found");
+        for (auto& deviceTableEntry : smbusDeviceTable)
+        {
+            unregisterEndpoint(std::get<0>(deviceTableEntry));
+        }
+        smbusDeviceTable.clear();
+    }
+}
+
+boost::asio::awaitable<void> SMBusBinding::registerDevices(
+    const std::set<std::pair<int, uint8_t>>& registerDeviceMap)
+{
+    size_t unchangedDevices = 0;
+    size_t livenessRequests = 0;
+
     /* Since i2c muxes restrict that only one command needs to be
      * in flight, we cannot register multiple endpoints in parallel.
-     * Thus, in a single yield_context, all the discovered devices
+     * Thus, in a single coroutine, all the discovered devices
      * are attempted with registration sequentially */
     for (const auto& device : registerDeviceMap)
     {
@@ -916,7 +942,8 @@ void SMBusBinding::initEndpointDiscovery(boost::asio::yield_context& yield)
             static_cast<uint8_t>((std::get<1>(device) << 1));
 
         auto const ptr = reinterpret_cast<uint8_t*>(&smbusBindingPvt);
-        std::vector<uint8_t> bindingPvtVect(ptr, ptr + sizeof(smbusBindingPvt));
+        mctpd::BindingPrivate bindingPvtVect(ptr,
+                                             ptr + sizeof(smbusBindingPvt));
         if (!deviceWatcher.isDeviceGoodForInit(bindingPvtVect))
         {
             phosphor::logging::log<phosphor::logging::level::DEBUG>(
@@ -925,11 +952,26 @@ void SMBusBinding::initEndpointDiscovery(boost::asio::yield_context& yield)
         }
 
         mctp_eid_t registeredEid = getEIDFromDeviceTable(bindingPvtVect);
+        if (incrementalRediscovery && registeredEid != MCTP_EID_NULL)
+        {
+            const size_t sentBefore = ctrlRequestsSent;
+            const bool alive =
+                co_await isRegisteredDeviceAlive(bindingPvtVect, registeredEid);
+            livenessRequests += ctrlRequestsSent - sentBefore;
+            if (alive)
+            {
+                unchangedDevices++;
+                continue;
+            }
+        }
+
+        const size_t sentBefore = ctrlRequestsSent;
         std::optional<mctp_eid_t> eid =
-            registerEndpoint(yield, bindingPvtVect, registeredEid);
+            co_await registerEndpoint(bindingPvtVect, registeredEid);
 
         if (eid.has_value() && eid.value() != MCTP_EID_NULL)
         {
+            registrationRequests = ctrlRequestsSent - sentBefore;
             DeviceTableEntry_t entry =
                 std::make_pair(eid.value(), smbusBindingPvt);
             bool newEntry = !isDeviceEntryPresent(entry, smbusDeviceTable);
@@ -965,16 +1007,18 @@ void SMBusBinding::initEndpointDiscovery(boost::asio::yield_context& yield)
         }
     }
 
-    // Add to check root device
-    if (registerDeviceMap.empty() && rootDeviceMap.empty())
+    if (unchangedDevices > 0)
     {
-        phosphor::logging::log<phosphor::logging::level::DEBUG>(
-            "No device found");
-        for (auto& deviceTableEntry : smbusDeviceTable)
-        {
-            unregisterEndpoint(std::get<0>(deviceTableEntry));
-        }
-        smbusDeviceTable.clear();
+        // Failed liveness checks are paid for on top of full registration
+        const size_t registrationCost = unchangedDevices * registrationRequests;
+        const size_t saved = registrationCost > livenessRequests
+                                 ? registrationCost - livenessRequests
+                                 : 0;
+        phosphor::logging::log<phosphor::logging::level::INFO>(
+            ("Device discovery: " + std::to_string(unchangedDevices) +
+             " registered devices unchanged, " + std::to_string(saved) +
+             " bus transactions saved")
+                .c_str());
     }
 }
 
@@ -1119,7 +1163,7 @@ void SMBusBinding::removeDeviceTableEntry(const mctp_eid_t eid)
 }
 
 mctp_eid_t SMBusBinding::getEIDFromDeviceTable(
-    const std::vector<uint8_t>& bindingPrivate)
+    const mctpd::BindingPrivate& bindingPrivate)
 {
     mctp_eid_t eid = MCTP_EID_NULL;
     for (auto& deviceEntry : smbusDeviceTable)
@@ -1138,6 +1182,29 @@ mctp_eid_t SMBusBinding::getEIDFromDeviceTable(
     return eid;
 }
 
+/*
+ * Single Get EID sent to EID of registered device. Device which does not
+ * answer, or lost its EID e.g. after reset, goes through full registration.
+ */
+boost::asio::awaitable<bool>
+    SMBusBinding::isRegisteredDeviceAlive(
+        const mctpd::BindingPrivate& bindingPrivate, const mctp_eid_t eid)
+{
+    if (endpointInterface.count(eid) == 0)
+    {
+        co_return false;
+    }
+
+    std::vector<uint8_t> getEidResp = {};
+    if (!co_await getEidCtrlCmd(bindingPrivate, eid, getEidResp))
+    {
+        co_return false;
+    }
+    auto getEidRespPtr =
+        reinterpret_cast<const mctp_ctrl_resp_get_eid*>(getEidResp.data());
+    co_return getEidRespPtr->eid == eid;
+}
+
 std::string SMBusBinding::convertToString(DiscoveryFlags flag)
 {
     std::string discoveredStr;
@@ -1264,22 +1331,23 @@ void SMBusBinding::updateRoutingTable()
     pktPrv.mux_flags = 0;
     pktPrv.slave_addr = busOwnerSlaveAddr;
     uint8_t* pktPrvPtr = reinterpret_cast<uint8_t*>(&pktPrv);
-    std::vector<uint8_t> prvData = std::vector<uint8_t>(
+    mctpd::BindingPrivate prvData = mctpd::BindingPrivate(
         pktPrvPtr, pktPrvPtr + sizeof(mctp_smbus_pkt_private));
 
-    boost::asio::spawn(io, [prvData, this](boost::asio::yield_context yield) {
+    auto readRoutingTable = [prvData, this]() -> boost::asio::awaitable<void> {
         std::vector<uint8_t> getRoutingTableEntryResp = {};
         std::vector<DeviceTableEntry_t> smbusDeviceTableTmp;
         uint8_t entryHandle = 0x00;
         uint8_t entryHdlCounter = 0x00;
         while ((entryHandle != 0xff) && (entryHdlCounter < 0xff))
         {
-            if (!getRoutingTableCtrlCmd(yield, prvData, busOwnerEid,
-                                        entryHandle, getRoutingTableEntryResp))
+            if (!co_await getRoutingTableCtrlCmd(prvData, busOwnerEid,
+                                                 entryHandle,
+                                                 getRoutingTableEntryResp))
             {
                 phosphor::logging::log<phosphor::logging::level::ERR>(
                     "Get Routing Table failed");
-                return;
+                co_return;
             }
 
             auto routingTableHdr =
@@ -1323,11 +1391,13 @@ void SMBusBinding::updateRoutingTable()
 
         if (isDeviceTableChanged(smbusDeviceTable, smbusDeviceTableTmp))
         {
-            processRoutingTableChanges(smbusDeviceTableTmp, yield, prvData);
+            co_await processRoutingTableChanges(smbusDeviceTableTmp, prvData);
             smbusDeviceTable = smbusDeviceTableTmp;
         }
         entryHdlCounter++;
-    }, boost::asio::detached);
+    };
+    boost::asio::co_spawn(io, std::move(readRoutingTable),
+                          boost::asio::detached);
 
     smbusRoutingTableTimer->expires_after(
         std::chrono::seconds(smbusRoutingInterval));
@@ -1338,9 +1408,9 @@ void SMBusBinding::updateRoutingTable()
 /* Function takes new routing table, detect changes and creates or removes
  * device interfaces on dbus.
  */
-void SMBusBinding::processRoutingTableChanges(
+boost::asio::awaitable<void> SMBusBinding::processRoutingTableChanges(
     const std::vector<DeviceTableEntry_t>& newTable,
-    boost::asio::yield_context& yield, const std::vector<uint8_t>& prvData)
+    const mctpd::BindingPrivate& prvData)
 {
     /* find removed endpoints, in case entry is not present
      * in the newly read routing table remove dbus interface
@@ -1362,14 +1432,14 @@ void SMBusBinding::processRoutingTableChanges(
     {
         if (!isDeviceEntryPresent(deviceTableEntry, smbusDeviceTable))
         {
-            registerEndpoint(yield, prvData, std::get<0>(deviceTableEntry),
-                             mctp_server::BindingModeTypes::Endpoint);
+            co_await registerEndpoint(prvData, std::get<0>(deviceTableEntry),
+                                      mctp_server::BindingModeTypes::Endpoint);
         }
     }
 }
 
 void SMBusBinding::updateRoutingTableEntry(
-    mctpd::RoutingTable::Entry entry, const std::vector<uint8_t>& privateData)
+    mctpd::RoutingTable::Entry entry, const mctpd::BindingPrivate& privateData)
 {
     constexpr uint8_t transportIdSmbus = 0x01;
     entry.routeEntry.routing_info.phys_transport_binding_id = transportIdSmbus;
@@ -1382,3 +1452,13 @@ void SMBusBinding::updateRoutingTableEntry(
 
     routingTable.updateEntry(entry.routeEntry.routing_info.starting_eid, entry);
 }
+
+bool SMBusBinding::isPipelinedRegistrationAllowed(
+    const mctpd::BindingPrivate& privateData)
+{
+    // Mux channel is held for one request at a time, so devices behind a mux
+    // are queried one after another
+    auto smbusData =
+        reinterpret_cast<const mctp_smbus_pkt_private*>(privateData.data());
+    return muxPortMap.count(smbusData->fd) == 0;
+}
@@ -104,6 +104,12 @@ int main(int argc, char* argv[])
     try
     {
         bindingPtr->setDbusName(mctpServiceName);
+        if (mctpdConfiguration->capabilityCache)
+        {
+            bindingPtr->loadCapabilityCache(
+                mctpd::CapabilityCache::defaultDirectory /
+                (mctpdName + ".cache"));
+        }
         bindingPtr->initializeBinding();
     }
     catch (const std::exception& e)
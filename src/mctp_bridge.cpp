@@ -17,116 +17,121 @@
 #include "mctp_bridge.hpp"
 
 #include "mctp_cmd_encoder.hpp"
+#include "utils/async_join.hpp"
 #include "utils/utils.hpp"
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <phosphor-logging/log.hpp>
 
 #include "libmctp-msgtypes.h"
 
 using RoutingTableEntry = mctpd::RoutingTable::Entry;
 
-constexpr int completionCodeIndex = 3;
 constexpr int noMoreSet = 0xFF;
 static const std::string nullUUID = "00000000-0000-0000-0000-000000000000";
 
 MCTPBridge::MCTPBridge(boost::asio::io_context& ioc,
                        std::shared_ptr<object_server>& objServer) :
-    MCTPEndpoint(ioc, objServer)
+    MCTPEndpoint(ioc, objServer), capabilityCache(ioc)
 {
 }
 
-bool MCTPBridge::getEidCtrlCmd(boost::asio::yield_context& yield,
-                               const std::vector<uint8_t>& bindingPrivate,
-                               const mctp_eid_t destEid,
-                               std::vector<uint8_t>& resp)
+bool MCTPBridge::loadCapabilityCache(const std::filesystem::path& file)
 {
-    std::vector<uint8_t> req = {};
+    return capabilityCache.load(file);
+}
 
-    if (!getFormattedReq<MCTP_CTRL_CMD_GET_ENDPOINT_ID>(req))
+boost::asio::awaitable<bool>
+    MCTPBridge::getEidCtrlCmd(const mctpd::BindingPrivate& bindingPrivate,
+                              const mctp_eid_t destEid,
+                              std::vector<uint8_t>& resp)
+{
+    auto req = getFormattedReq<MCTP_CTRL_CMD_GET_ENDPOINT_ID>();
+    if (!req)
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get EID: Request formatting failed");
-        return false;
+        co_return false;
     }
 
     if (PacketState::receivedResponse !=
-        sendAndRcvMctpCtrl(yield, req, destEid, bindingPrivate, resp))
+        co_await sendAndRcvMctpCtrl(*req, destEid, bindingPrivate, resp))
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get EID: Unable to get response");
-        return false;
+        co_return false;
     }
 
     if (!checkRespSizeAndCompletionCode<mctp_ctrl_resp_get_eid>(resp))
     {
         phosphor::logging::log<phosphor::logging::level::ERR>("Get EID failed");
-        return false;
+        co_return false;
     }
 
     phosphor::logging::log<phosphor::logging::level::DEBUG>("Get EID success");
-    return true;
+    co_return true;
 }
 
-bool MCTPBridge::setEidCtrlCmd(boost::asio::yield_context& yield,
-                               const std::vector<uint8_t>& bindingPrivate,
-                               const mctp_eid_t destEid,
-                               const mctp_ctrl_cmd_set_eid_op operation,
-                               mctp_eid_t eid, std::vector<uint8_t>& resp)
+boost::asio::awaitable<bool>
+    MCTPBridge::setEidCtrlCmd(const mctpd::BindingPrivate& bindingPrivate,
+                              const mctp_eid_t destEid,
+                              const mctp_ctrl_cmd_set_eid_op operation,
+                              mctp_eid_t eid, std::vector<uint8_t>& resp)
 {
-    std::vector<uint8_t> req = {};
-
-    if (!getFormattedReq<MCTP_CTRL_CMD_SET_ENDPOINT_ID>(req, operation, eid))
+    auto req = getFormattedReq<MCTP_CTRL_CMD_SET_ENDPOINT_ID>(operation, eid);
+    if (!req)
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Set EID: Request formatting failed");
-        return false;
+        co_return false;
     }
 
     if (PacketState::receivedResponse !=
-        sendAndRcvMctpCtrl(yield, req, destEid, bindingPrivate, resp))
+        co_await sendAndRcvMctpCtrl(*req, destEid, bindingPrivate, resp))
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Set EID: Unable to get response");
-        return false;
+        co_return false;
     }
 
     if (!checkRespSizeAndCompletionCode<mctp_ctrl_resp_set_eid>(resp))
     {
         phosphor::logging::log<phosphor::logging::level::ERR>("Set EID failed");
-        return false;
+        co_return false;
     }
 
     phosphor::logging::log<phosphor::logging::level::DEBUG>("Set EID success");
-    return true;
+    co_return true;
 }
 
-bool MCTPBridge::getUuidCtrlCmd(boost::asio::yield_context& yield,
-                                const std::vector<uint8_t>& bindingPrivate,
-                                const mctp_eid_t destEid,
-                                std::vector<uint8_t>& resp)
+boost::asio::awaitable<bool>
+    MCTPBridge::getUuidCtrlCmd(const mctpd::BindingPrivate& bindingPrivate,
+                               const mctp_eid_t destEid,
+                               std::vector<uint8_t>& resp)
 {
-    std::vector<uint8_t> req = {};
-
-    if (!getFormattedReq<MCTP_CTRL_CMD_GET_ENDPOINT_UUID>(req))
+    auto req = getFormattedReq<MCTP_CTRL_CMD_GET_ENDPOINT_UUID>();
+    if (!req)
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get UUID: Request formatting failed");
-        return false;
+        co_return false;
     }
 
     if (PacketState::receivedResponse !=
-        sendAndRcvMctpCtrl(yield, req, destEid, bindingPrivate, resp))
+        co_await sendAndRcvMctpCtrl(*req, destEid, bindingPrivate, resp))
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get UUID: Unable to get response");
-        return false;
+        co_return false;
     }
 
     if (!checkRespSizeAndCompletionCode<mctp_ctrl_resp_get_uuid>(resp))
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get UUID failed");
-        return false;
+        co_return false;
     }
 
     const std::string nilUUID = "00000000-0000-0000-0000-000000000000";
@@ -137,236 +142,131 @@ bool MCTPBridge::getUuidCtrlCmd(boost::asio::yield_context& yield,
     {
         phosphor::logging::log<phosphor::logging::level::DEBUG>(
             "Get UUID: Device returned Nil UUID");
-        return false;
+        co_return false;
     }
 
     phosphor::logging::log<phosphor::logging::level::DEBUG>(
         ("Get UUID success: " + uuidResp).c_str());
-    return true;
+    co_return true;
 }
 
-bool MCTPBridge::getMsgTypeSupportCtrlCmd(
-    boost::asio::yield_context& yield,
-    const std::vector<uint8_t>& bindingPrivate, const mctp_eid_t destEid,
-    MsgTypeSupportCtrlResp* msgTypeSupportResp)
+boost::asio::awaitable<std::optional<mctpd::MsgTypeSupportView>>
+    MCTPBridge::getMsgTypeSupportCtrlCmd(
+        const mctpd::BindingPrivate& bindingPrivate, const mctp_eid_t destEid,
+        std::vector<uint8_t>& resp)
 {
-    std::vector<uint8_t> req = {};
-    std::vector<uint8_t> resp = {};
-
-    if (!getFormattedReq<MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT>(req))
+    auto req = getFormattedReq<MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT>();
+    if (!req)
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get Message Type Support: Request formatting failed");
-        return false;
+        co_return std::nullopt;
     }
 
     if (PacketState::receivedResponse !=
-        sendAndRcvMctpCtrl(yield, req, destEid, bindingPrivate, resp))
+        co_await sendAndRcvMctpCtrl(*req, destEid, bindingPrivate, resp))
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get Message Type Support: Unable to get response");
-        return false;
+        co_return std::nullopt;
     }
 
-    if (!checkMinRespSize(resp))
+    auto msgTypeSupport = mctpd::MsgTypeSupportView::decode(resp);
+    if (!msgTypeSupport)
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get Message Type Support: Invalid response");
-        return false;
-    }
-
-    const size_t minMsgTypeRespLen = 5;
-    uint8_t completionCode = resp[completionCodeIndex];
-    if (completionCode != MCTP_CTRL_CC_SUCCESS ||
-        resp.size() <= minMsgTypeRespLen)
-    {
-        phosphor::logging::log<phosphor::logging::level::ERR>(
-            "Get Message Type Support: Invalid response",
-            phosphor::logging::entry("CC=0x%02X", completionCode),
-            phosphor::logging::entry("LEN=0x%02X", resp.size()));
-
-        std::vector<uint8_t> respHeader =
-            std::vector<uint8_t>(resp.begin(), resp.begin() + minCmdRespSize);
-        std::copy(
-            respHeader.begin(), respHeader.end(),
-            reinterpret_cast<uint8_t*>(&msgTypeSupportResp->ctrlMsgHeader));
-        msgTypeSupportResp->completionCode = completionCode;
-        return false;
+        co_return std::nullopt;
     }
 
-    std::copy_n(resp.begin(), minMsgTypeRespLen,
-                reinterpret_cast<uint8_t*>(msgTypeSupportResp));
-    if ((resp.size() - minMsgTypeRespLen) != msgTypeSupportResp->msgTypeCount)
-    {
-        phosphor::logging::log<phosphor::logging::level::ERR>(
-            "Get Message Type Support: Invalid response length");
-        return false;
-    }
-
-    msgTypeSupportResp->msgType.assign(resp.begin() + minMsgTypeRespLen,
-                                       resp.end());
-
     phosphor::logging::log<phosphor::logging::level::DEBUG>(
         "Get Message Type Support success");
-    return true;
+    co_return msgTypeSupport;
 }
 
-bool MCTPBridge::getMctpVersionSupportCtrlCmd(
-    boost::asio::yield_context& yield,
-    const std::vector<uint8_t>& bindingPrivate, const mctp_eid_t destEid,
-    const uint8_t msgTypeNo,
-    MctpVersionSupportCtrlResp* mctpVersionSupportCtrlResp)
+boost::asio::awaitable<std::optional<mctpd::VersionSupportView>>
+    MCTPBridge::getMctpVersionSupportCtrlCmd(
+        const mctpd::BindingPrivate& bindingPrivate, const mctp_eid_t destEid,
+        const uint8_t msgTypeNo, std::vector<uint8_t>& resp)
 {
-    std::vector<uint8_t> req = {};
-    std::vector<uint8_t> resp = {};
-
-    if (!getFormattedReq<MCTP_CTRL_CMD_GET_VERSION_SUPPORT>(req, msgTypeNo))
+    auto req = getFormattedReq<MCTP_CTRL_CMD_GET_VERSION_SUPPORT>(msgTypeNo);
+    if (!req)
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get MCTP Version Support: Request formatting failed");
-        return false;
+        co_return std::nullopt;
     }
 
     if (PacketState::receivedResponse !=
-        sendAndRcvMctpCtrl(yield, req, destEid, bindingPrivate, resp))
+        co_await sendAndRcvMctpCtrl(*req, destEid, bindingPrivate, resp))
     {
         phosphor::logging::log<phosphor::logging::level::DEBUG>(
             "Get MCTP Version Support: Unable to get response");
-        return false;
+        co_return std::nullopt;
     }
 
-    if (!checkMinRespSize(resp))
+    auto versionSupport = mctpd::VersionSupportView::decode(resp);
+    if (!versionSupport)
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get MCTP Version Support: Invalid response");
-        return false;
-    }
-
-    const size_t minMsgTypeRespLen = 5;
-    const size_t mctpVersionLen = 4;
-    uint8_t completionCode = resp[completionCodeIndex];
-    if (completionCode != MCTP_CTRL_CC_SUCCESS ||
-        resp.size() <= minMsgTypeRespLen)
-    {
-        phosphor::logging::log<phosphor::logging::level::ERR>(
-            "Get MCTP Version Support: Invalid response",
-            phosphor::logging::entry("CC=0x%02X", completionCode),
-            phosphor::logging::entry("LEN=0x%02X", resp.size()));
-
-        std::vector<uint8_t> respHeader =
-            std::vector<uint8_t>(resp.begin(), resp.begin() + minCmdRespSize);
-        std::copy(respHeader.begin(), respHeader.end(),
-                  reinterpret_cast<uint8_t*>(
-                      &mctpVersionSupportCtrlResp->ctrlMsgHeader));
-        mctpVersionSupportCtrlResp->completionCode = completionCode;
-        return false;
-    }
-
-    std::copy_n(resp.begin(), minMsgTypeRespLen,
-                reinterpret_cast<uint8_t*>(mctpVersionSupportCtrlResp));
-    if ((resp.size() - minMsgTypeRespLen) !=
-        mctpVersionSupportCtrlResp->verNoEntryCount * mctpVersionLen)
-    {
-        phosphor::logging::log<phosphor::logging::level::ERR>(
-            "Get MCTP Version Support: Invalid response length");
-        return false;
-    }
-
-    for (size_t iter = 1; iter <= mctpVersionSupportCtrlResp->verNoEntryCount;
-         iter++)
-    {
-        size_t verNoEntryStartOffset =
-            minMsgTypeRespLen + (mctpVersionLen * (iter - 1));
-        struct MCTPVersionFields versionData = {};
-        versionData.major = resp[verNoEntryStartOffset];
-        versionData.minor = resp[verNoEntryStartOffset + 1];
-        versionData.update = resp[verNoEntryStartOffset + 2];
-        versionData.alpha = resp[verNoEntryStartOffset + 3];
-        mctpVersionSupportCtrlResp->verNoEntry.push_back(
-            std::move(versionData));
+        co_return std::nullopt;
     }
 
     phosphor::logging::log<phosphor::logging::level::DEBUG>(
         "Get MCTP Version Support success");
-    return true;
+    co_return versionSupport;
 }
 
-bool MCTPBridge::getPCIVDMessageSupportCtrlCmd(
-    boost::asio::yield_context& yield,
-    const std::vector<uint8_t>& bindingPrivate, const mctp_eid_t destEid,
+boost::asio::awaitable<bool> MCTPBridge::getPCIVDMessageSupportCtrlCmd(
+    const mctpd::BindingPrivate& bindingPrivate, const mctp_eid_t destEid,
     std::vector<uint16_t>& vendorSetIdList, std::string& venFormatData)
 {
     phosphor::logging::log<phosphor::logging::level::DEBUG>(
         "getPCIVendorIdMessageSupportCtrlCmd called...");
-    std::vector<uint8_t> req = {};
     std::vector<uint8_t> resp = {};
     uint8_t vendorIdSet = 0;
     venFormatData.clear();
-    // local structure to receive the vendor ID response
-    MctpVendIdMsgSupportResp pciVendIdMsgSupportResp;
     // cannot be sure of the count, so processing from 0 ~ 255
     while (vendorIdSet < 255)
     {
         // format the data as per the request msg format
-        if (!getFormattedReq<MCTP_CTRL_CMD_GET_VENDOR_MESSAGE_SUPPORT>(
-                req, vendorIdSet))
+        auto req = getFormattedReq<MCTP_CTRL_CMD_GET_VENDOR_MESSAGE_SUPPORT>(
+            vendorIdSet);
+        if (!req)
         {
             phosphor::logging::log<phosphor::logging::level::ERR>(
                 "Get MCTP Vendor Id Support: Request formatting failed");
-            return false;
+            co_return false;
         }
 
         if (PacketState::receivedResponse !=
-            sendAndRcvMctpCtrl(yield, req, destEid, bindingPrivate, resp))
+            co_await sendAndRcvMctpCtrl(*req, destEid, bindingPrivate, resp))
         {
             phosphor::logging::log<phosphor::logging::level::ERR>(
                 "Get MCTP Vendor Id Support: sending & receiving failed");
-            return false;
+            co_return false;
         }
 
-        // total resp size(including ctrl header) '10'
         // ctrlheader  Compl.Code  VendIdSet  VendIdFmt  VendorFrmtData
         // vendIdSetType
         //     3           1          1          1             2             2
         //     (bytes)
-        const ssize_t pciVDMessageSupportCmdRespSize =
-            sizeof(MctpVendIdMsgSupportResp);
-
-        if (!checkMinRespSize(resp))
+        auto vdmSupport = mctpd::VdmSupportView::decode(resp);
+        if (!vdmSupport)
         {
             phosphor::logging::log<phosphor::logging::level::ERR>(
-                "Get MCTP Vendor Id Support: Invalid Response Length");
-            return false;
+                "Get MCTP Vendor Id Support: Invalid response");
+            co_return false;
         }
 
-        // assuming 1st byte after ctrl header is completion code index
-        uint8_t completionCode = resp[completionCodeIndex];
-        if ((completionCode != MCTP_CTRL_CC_SUCCESS) ||
-            (resp.size() < pciVDMessageSupportCmdRespSize))
-        {
-
-            phosphor::logging::log<phosphor::logging::level::ERR>(
-                "Get MCTP Vendor Id Support: Invalid response",
-                phosphor::logging::entry("CC=0x%02X", completionCode),
-                phosphor::logging::entry("LEN=0x%02X", resp.size()));
-            return false;
-        }
-
-        pciVendIdMsgSupportResp = {};
-
-        // copy the response onto local structure
-        std::copy_n(resp.begin(), pciVDMessageSupportCmdRespSize,
-                    reinterpret_cast<uint8_t*>(&pciVendIdMsgSupportResp));
-
-        uint16_t venid = htobe16(pciVendIdMsgSupportResp.vendorIdFormatData);
+        // Filled from every response, so sets read before a failure are kept
         std::stringstream op_str;
-        op_str << std::hex << venid;
+        op_str << std::hex << vdmSupport->vendorIdFormatData();
         venFormatData = op_str.str();
+        vendorSetIdList.push_back(vdmSupport->commandSetType());
 
-        vendorSetIdList.push_back(
-            htobe16(pciVendIdMsgSupportResp.vendorIdSetCmdType));
-
-        if (pciVendIdMsgSupportResp.vendorIdSet == noMoreSet)
+        if (vdmSupport->vendorIdSet() == noMoreSet)
         {
             // break the loop once 0xFF is found in set.
             vendorIdSet = 0;
@@ -375,45 +275,42 @@ bool MCTPBridge::getPCIVDMessageSupportCtrlCmd(
             break;
         }
         vendorIdSet++;
-        if (vendorIdSet == 255 &&
-            pciVendIdMsgSupportResp.vendorIdSet != noMoreSet)
+        if (vendorIdSet == 255 && vdmSupport->vendorIdSet() != noMoreSet)
         { // invalid scenario iteration
             phosphor::logging::log<phosphor::logging::level::ERR>(
                 "Invalid vendor ID set iteration");
-            return false;
+            co_return false;
         }
     }
-    return true;
+    co_return true;
 }
 
-bool MCTPBridge::getRoutingTableCtrlCmd(
-    boost::asio::yield_context& yield,
-    const std::vector<uint8_t>& bindingPrivate, const mctp_eid_t destEid,
+boost::asio::awaitable<bool> MCTPBridge::getRoutingTableCtrlCmd(
+    const mctpd::BindingPrivate& bindingPrivate, const mctp_eid_t destEid,
     uint8_t entryHandle, std::vector<uint8_t>& resp)
 {
-    std::vector<uint8_t> req = {};
-
-    if (!getFormattedReq<MCTP_CTRL_CMD_GET_ROUTING_TABLE_ENTRIES>(req,
-                                                                  entryHandle))
+    auto req = getFormattedReq<MCTP_CTRL_CMD_GET_ROUTING_TABLE_ENTRIES>(
+        entryHandle);
+    if (!req)
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get Routing Table Entry: Request formatting failed");
-        return false;
+        co_return false;
     }
 
     if (PacketState::receivedResponse !=
-        sendAndRcvMctpCtrl(yield, req, destEid, bindingPrivate, resp))
+        co_await sendAndRcvMctpCtrl(*req, destEid, bindingPrivate, resp))
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get Routing Table Entry: Unable to get response");
-        return false;
+        co_return false;
     }
 
     if (!checkMinRespSize(resp))
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Invalid response length");
-        return false;
+        co_return false;
     }
 
     uint8_t* respPtr = resp.data();
@@ -421,7 +318,7 @@ bool MCTPBridge::getRoutingTableCtrlCmd(
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Get Routing Table Entry: Unsuccessful completion code");
-        return false;
+        co_return false;
     }
 
     if (resp.size() < sizeof(mctp_ctrl_resp_get_routing_table))
@@ -430,7 +327,7 @@ bool MCTPBridge::getRoutingTableCtrlCmd(
             "Get Routing Table Entry: Response length is too short: Cannot "
             "read number of entries",
             phosphor::logging::entry("LEN=%d", resp.size()));
-        return false;
+        co_return false;
     }
 
     mctp_ctrl_resp_get_routing_table* routingTableHdr =
@@ -448,7 +345,7 @@ bool MCTPBridge::getRoutingTableCtrlCmd(
                 "Get Routing Table Entry: Response length is too short: Cannot "
                 "read routing table entry",
                 phosphor::logging::entry("LEN=%d", resp.size()));
-            return false;
+            co_return false;
         }
 
         entryOffset += routingTableEntry->phys_address_size;
@@ -458,7 +355,7 @@ bool MCTPBridge::getRoutingTableCtrlCmd(
                 "Get Routing Table Entry: Response length is too short: Cannot "
                 "read physical address",
                 phosphor::logging::entry("LEN=%d", resp.size()));
-            return false;
+            co_return false;
         }
     }
 
@@ -468,17 +365,27 @@ bool MCTPBridge::getRoutingTableCtrlCmd(
             "Get Routing Table Entry: Invalid response length",
             phosphor::logging::entry("LEN=%d", resp.size()),
             phosphor::logging::entry("EXPECTED_LEN=%d", entryOffset));
-        return false;
+        co_return false;
     }
 
     phosphor::logging::log<phosphor::logging::level::INFO>(
         "Get Routing Table Entry success");
-    return true;
+    co_return true;
+}
+
+static std::vector<MCTPVersionFields>
+    getVersionList(const mctpd::VersionSupportView& versions)
+{
+    std::vector<MCTPVersionFields> versionList;
+    for (size_t i = 0; i < versions.count(); i++)
+    {
+        versionList.push_back(versions.version(i));
+    }
+    return versionList;
 }
 
 void MCTPBridge::logUnsupportedMCTPVersion(
-    const std::vector<struct MCTPVersionFields> versionsData,
-    const mctp_eid_t eid)
+    const std::vector<MCTPVersionFields>& versions, const mctp_eid_t eid)
 {
     static std::vector<mctp_eid_t> incompatibleEIDs;
 
@@ -488,15 +395,12 @@ void MCTPBridge::logUnsupportedMCTPVersion(
         return;
     }
 
-    auto versionIter =
-        std::find_if(versionsData.begin(), versionsData.end(),
-                     [this](const auto& versionEntry) {
-                         return isMCTPVersionSupported(versionEntry);
-                     });
-
-    if (versionIter != versionsData.end())
+    for (const auto& version : versions)
     {
-        return;
+        if (isMCTPVersionSupported(version))
+        {
+            return;
+        }
     }
 
     phosphor::logging::log<phosphor::logging::level::WARNING>(
@@ -525,28 +429,63 @@ static std::optional<mctp_eid_t> checkEIDMismatchAndGetEID(mctp_eid_t eid,
     return eid;
 }
 
-std::optional<mctp_eid_t> MCTPBridge::busOwnerRegisterEndpoint(
-    boost::asio::yield_context& yield,
-    const std::vector<uint8_t>& bindingPrivate, mctp_eid_t eid)
+boost::asio::awaitable<std::optional<mctp_eid_t>>
+    MCTPBridge::busOwnerRegisterEndpoint(
+        const mctpd::BindingPrivate& bindingPrivate, mctp_eid_t eid)
 {
-    MctpVersionSupportCtrlResp getMctpControlVersion = {};
-    if (!(getMctpVersionSupportCtrlCmd(yield, bindingPrivate, MCTP_EID_NULL,
-                                       MCTP_MESSAGE_TYPE_MCTP_CTRL,
-                                       &getMctpControlVersion)))
+    std::vector<uint8_t> getVersionResp = {};
+    std::optional<mctpd::VersionSupportView> getMctpControlVersion;
+    std::vector<uint8_t> getEidResp = {};
+    bool gotEid = false;
+    std::vector<uint8_t> getUuidResp = {};
+    bool gotUuid = false;
+    std::vector<uint8_t> msgTypeSupportResp = {};
+    std::optional<mctpd::MsgTypeSupportView> msgTypeSupport;
+
+    auto getControlVersion = [&]() -> boost::asio::awaitable<bool> {
+        getMctpControlVersion = co_await getMctpVersionSupportCtrlCmd(
+            bindingPrivate, MCTP_EID_NULL, MCTP_MESSAGE_TYPE_MCTP_CTRL,
+            getVersionResp);
+        if (!getMctpControlVersion)
+        {
+            phosphor::logging::log<phosphor::logging::level::DEBUG>(
+                "Get MCTP Control Version failed");
+        }
+        co_return getMctpControlVersion.has_value();
+    };
+
+    const bool pipelined = isPipelinedRegistrationAllowed(bindingPrivate);
+    // Without pipelining the device is queried in its usual order, Get
+    // Version first, so that the one failing it is not unregistered below
+    if (!pipelined && !(co_await getControlVersion()))
     {
-        phosphor::logging::log<phosphor::logging::level::DEBUG>(
-            "Get MCTP Control Version failed");
-        return std::nullopt;
+        co_return std::nullopt;
     }
 
-    // TODO: Validate MCTP Control message version supported
-
-    std::vector<uint8_t> getEidResp = {};
-    if (!(getEidCtrlCmd(yield, bindingPrivate, MCTP_EID_NULL, getEidResp)))
+    if (pipelined)
+    {
+        // Get EID and Get UUID do not depend on each other. Only two of the
+        // tags of null EID are taken, they are shared by every registration
+        // in progress on the binding.
+        std::vector<boost::asio::awaitable<void>> queries;
+        queries.push_back(mctpd::assignResult(
+            getEidCtrlCmd(bindingPrivate, MCTP_EID_NULL, getEidResp), gotEid));
+        queries.push_back(mctpd::assignResult(
+            getUuidCtrlCmd(bindingPrivate, MCTP_EID_NULL, getUuidResp),
+            gotUuid));
+        co_await mctpd::asyncJoin(io.get_executor(), std::move(queries),
+                                  boost::asio::use_awaitable);
+    }
+    else
+    {
+        gotEid =
+            co_await getEidCtrlCmd(bindingPrivate, MCTP_EID_NULL, getEidResp);
+    }
+    if (!gotEid)
     {
         phosphor::logging::log<phosphor::logging::level::DEBUG>(
             "Get EID failed");
-        return std::nullopt;
+        co_return std::nullopt;
     }
     const mctp_ctrl_resp_get_eid* getEidRespPtr =
         reinterpret_cast<mctp_ctrl_resp_get_eid*>(getEidResp.data());
@@ -554,20 +493,22 @@ std::optional<mctp_eid_t> MCTPBridge::busOwnerRegisterEndpoint(
         checkEIDMismatchAndGetEID(eid, getEidRespPtr->eid);
     if (!destEID.has_value())
     {
-        return std::nullopt;
+        co_return std::nullopt;
     }
     eid = destEID.value();
 
-    logUnsupportedMCTPVersion(getMctpControlVersion.verNoEntry, eid);
-
-    std::vector<uint8_t> getUuidResp = {};
-    if (!(getUuidCtrlCmd(yield, bindingPrivate, MCTP_EID_NULL, getUuidResp)))
+    if (!pipelined)
+    {
+        gotUuid =
+            co_await getUuidCtrlCmd(bindingPrivate, MCTP_EID_NULL, getUuidResp);
+    }
+    if (!gotUuid)
     {
         phosphor::logging::log<phosphor::logging::level::DEBUG>(
             "Get UUID failed");
         if (isEIDRegistered(getEidRespPtr->eid))
         {
-            return getEidRespPtr->eid;
+            co_return getEidRespPtr->eid;
         }
 
         if (eid != MCTP_EID_NULL)
@@ -585,16 +526,42 @@ std::optional<mctp_eid_t> MCTPBridge::busOwnerRegisterEndpoint(
     std::string destUUID = formatUUID(getUuidRespPtr->uuid);
     if (isEIDMappedToUUID(getEidRespPtr->eid, destUUID))
     {
-        return getEidRespPtr->eid;
+        co_return getEidRespPtr->eid;
     }
     if (auto uuidMappedEID = getEIDForReregistration(destUUID))
     {
         eid = uuidMappedEID.value();
     }
 
+    // Capabilities of endpoint known from its previous registration are
+    // published without querying them, they are refreshed once it is
+    // registered
+    std::optional<mctpd::CapabilityCache::Entry> cached;
+    if (destUUID != nullUUID)
+    {
+        cached = capabilityCache.find(destUUID);
+    }
+
+    std::vector<MCTPVersionFields> controlVersions;
+    if (!cached && !getMctpControlVersion && !(co_await getControlVersion()))
+    {
+        co_return std::nullopt;
+    }
+    if (getMctpControlVersion)
+    {
+        controlVersions = getVersionList(*getMctpControlVersion);
+    }
+    else
+    {
+        controlVersions = cached->controlVersions;
+    }
+
+    // TODO: Validate MCTP Control message version supported
+    logUnsupportedMCTPVersion(controlVersions, eid);
+
     if (!deviceWatcher.checkDeviceInitThreshold(bindingPrivate))
     {
-        return std::nullopt;
+        co_return std::nullopt;
     }
 
     if (eid == MCTP_EID_NULL)
@@ -605,7 +572,7 @@ std::optional<mctp_eid_t> MCTPBridge::busOwnerRegisterEndpoint(
         }
         catch (const std::exception&)
         {
-            return std::nullopt;
+            co_return std::nullopt;
         }
     }
 
@@ -615,13 +582,13 @@ std::optional<mctp_eid_t> MCTPBridge::busOwnerRegisterEndpoint(
 
     // Set EID
     std::vector<uint8_t> setEidResp = {};
-    if (!(setEidCtrlCmd(yield, bindingPrivate, MCTP_EID_NULL, set_eid, eid,
-                        setEidResp)))
+    if (!(co_await setEidCtrlCmd(bindingPrivate, MCTP_EID_NULL, set_eid, eid,
+                                 setEidResp)))
     {
         phosphor::logging::log<phosphor::logging::level::DEBUG>(
             "Set EID failed");
         eidPool.updateEidStatus(eid, false);
-        return std::nullopt;
+        co_return std::nullopt;
     }
     mctp_ctrl_resp_set_eid* setEidRespPtr =
         reinterpret_cast<mctp_ctrl_resp_set_eid*>(setEidResp.data());
@@ -631,18 +598,31 @@ std::optional<mctp_eid_t> MCTPBridge::busOwnerRegisterEndpoint(
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Set EID failed. Reported different EID in the response.");
         eidPool.updateEidStatus(eid, false);
-        return std::nullopt;
+        co_return std::nullopt;
     }
     eidPool.updateEidStatus(eid, true);
 
-    // Get Message Type Support
-    MsgTypeSupportCtrlResp msgTypeSupportResp;
-    if (!(getMsgTypeSupportCtrlCmd(yield, bindingPrivate, eid,
-                                   &msgTypeSupportResp)))
+    // Get Message Type Support, endpoints may accept only Set EID on null EID
+    if (!cached)
+    {
+        msgTypeSupport = co_await getMsgTypeSupportCtrlCmd(
+            bindingPrivate, eid, msgTypeSupportResp);
+    }
+    std::vector<uint8_t> msgTypes;
+    if (msgTypeSupport)
+    {
+        msgTypes.assign(msgTypeSupport->msgTypes().begin(),
+                        msgTypeSupport->msgTypes().end());
+    }
+    else if (cached)
+    {
+        msgTypes = cached->msgTypes;
+    }
+    else
     {
         phosphor::logging::log<phosphor::logging::level::DEBUG>(
             "Get Message Type Support failed");
-        return std::nullopt;
+        co_return std::nullopt;
     }
 
     // check if EID is already registered
@@ -650,7 +630,7 @@ std::optional<mctp_eid_t> MCTPBridge::busOwnerRegisterEndpoint(
     {
         phosphor::logging::log<phosphor::logging::level::WARNING>(
             ("EID " + std::to_string(eid) + " is already registered").c_str());
-        return std::nullopt;
+        co_return std::nullopt;
     }
 
     // Expose interface as per the result
@@ -663,13 +643,22 @@ std::optional<mctp_eid_t> MCTPBridge::busOwnerRegisterEndpoint(
     }
     catch (const std::exception&)
     {
-        return std::nullopt;
+        co_return std::nullopt;
     }
     // Network ID need to be assigned only if EP is requesting for the same.
     // Keep Network ID as zero and update it later if a change happend.
     epProperties.networkId = 0x00;
-    epProperties.endpointMsgTypes = getMsgTypes(msgTypeSupportResp.msgType);
-    getVendorDefinedMessageTypes(yield, bindingPrivate, eid, epProperties);
+    epProperties.endpointMsgTypes = getMsgTypes(msgTypes);
+    if (cached && cached->msgTypes == msgTypes)
+    {
+        epProperties.vendorIdFormat = cached->vendorIdFormat;
+        epProperties.vendorIdCapabilitySets = cached->vendorIdCapabilitySets;
+    }
+    else
+    {
+        co_await getVendorDefinedMessageTypes(bindingPrivate, eid,
+                                              epProperties);
+    }
     epProperties.locationCode = getLocationCode(bindingPrivate).value_or("");
 
     populateDeviceProperties(eid, bindingPrivate);
@@ -690,24 +679,93 @@ std::optional<mctp_eid_t> MCTPBridge::busOwnerRegisterEndpoint(
     if (destUUID != nullUUID && eid != MCTP_EID_NULL)
     {
         uuidTable.insert_or_assign(eid, destUUID);
+
+        mctpd::CapabilityCache::Entry capabilities{
+            controlVersions, msgTypes, epProperties.vendorIdFormat,
+            epProperties.vendorIdCapabilitySets};
+        if (cached)
+        {
+            boost::asio::co_spawn(io,
+                                  refreshCapabilities(bindingPrivate, eid,
+                                                      destUUID,
+                                                      std::move(capabilities)),
+                                  boost::asio::detached);
+        }
+        else
+        {
+            capabilityCache.store(destUUID, capabilities);
+        }
     }
 
     phosphor::logging::log<phosphor::logging::level::INFO>(
         ("Device Registered: EID = " + std::to_string(eid)).c_str());
-    return eid;
+    co_return eid;
 }
 
-void MCTPBridge::getVendorDefinedMessageTypes(
-    boost::asio::yield_context yield,
-    const std::vector<uint8_t>& bindingPrivate, mctp_eid_t destEid,
+/*
+ * Queries capabilities of endpoint registered from the cache. Interfaces are
+ * updated only if they differ from the published ones, cache entry is
+ * updated with versions as well.
+ */
+boost::asio::awaitable<void> MCTPBridge::refreshCapabilities(
+    mctpd::BindingPrivate bindingPrivate, mctp_eid_t eid, std::string uuid,
+    mctpd::CapabilityCache::Entry published)
+{
+    std::vector<uint8_t> getVersionResp = {};
+    auto getMctpControlVersion = co_await getMctpVersionSupportCtrlCmd(
+        bindingPrivate, eid, MCTP_MESSAGE_TYPE_MCTP_CTRL, getVersionResp);
+    std::vector<uint8_t> msgTypeSupportResp = {};
+    auto msgTypeSupport = co_await getMsgTypeSupportCtrlCmd(
+        bindingPrivate, eid, msgTypeSupportResp);
+    if (!getMctpControlVersion || !msgTypeSupport)
+    {
+        phosphor::logging::log<phosphor::logging::level::DEBUG>(
+            "Capability refresh failed",
+            phosphor::logging::entry("EID=%d", eid));
+        co_return;
+    }
+
+    EndpointProperties epProperties;
+    epProperties.endpointEid = eid;
+    epProperties.endpointMsgTypes = getMsgTypes(msgTypeSupport->msgTypes());
+    co_await getVendorDefinedMessageTypes(bindingPrivate, eid, epProperties);
+
+    // Endpoint could have been unregistered while queries were in flight
+    auto uuidIt = uuidTable.find(eid);
+    if (uuidIt == uuidTable.end() || uuidIt->second != uuid)
+    {
+        co_return;
+    }
+
+    mctpd::CapabilityCache::Entry refreshed{
+        getVersionList(*getMctpControlVersion),
+        {msgTypeSupport->msgTypes().begin(), msgTypeSupport->msgTypes().end()},
+        epProperties.vendorIdFormat,
+        epProperties.vendorIdCapabilitySets};
+    capabilityCache.store(uuid, refreshed);
+
+    if (refreshed.msgTypes != published.msgTypes ||
+        refreshed.vendorIdFormat != published.vendorIdFormat ||
+        refreshed.vendorIdCapabilitySets != published.vendorIdCapabilitySets)
+    {
+        phosphor::logging::log<phosphor::logging::level::INFO>(
+            ("Capabilities of EID " + std::to_string(eid) +
+             " changed since they were cached")
+                .c_str());
+        updateCapabilityProperties(epProperties);
+    }
+}
+
+boost::asio::awaitable<void> MCTPBridge::getVendorDefinedMessageTypes(
+    const mctpd::BindingPrivate& bindingPrivate, mctp_eid_t destEid,
     EndpointProperties& epProperties)
 {
     if (epProperties.endpointMsgTypes.vdpci)
     {
         std::vector<uint16_t> vendorSetIdList = {};
         std::string vendorFormat;
-        if (!getPCIVDMessageSupportCtrlCmd(yield, bindingPrivate, destEid,
-                                           vendorSetIdList, vendorFormat))
+        if (!co_await getPCIVDMessageSupportCtrlCmd(
+                bindingPrivate, destEid, vendorSetIdList, vendorFormat))
         {
             phosphor::logging::log<phosphor::logging::level::ERR>(
                 "Get Vendor Id Support failed");
@@ -717,7 +775,7 @@ void MCTPBridge::getVendorDefinedMessageTypes(
             */
             epProperties.vendorIdFormat = "0x0";
             epProperties.vendorIdCapabilitySets = {};
-            return;
+            co_return;
         }
         epProperties.vendorIdCapabilitySets.assign(vendorSetIdList.begin(),
                                                    vendorSetIdList.end());
@@ -753,11 +811,11 @@ static std::vector<uint8_t> formatRoutingInfoUpdateCommand(
 
 void MCTPBridge::sendRoutingTableEntries(
     const std::vector<RoutingTableEntry::MCTPLibData>& entries,
-    std::optional<std::vector<uint8_t>> bindingPrivateData,
+    std::optional<mctpd::BindingPrivate> bindingPrivateData,
     const mctp_eid_t eid)
 {
-    boost::asio::spawn([entries = entries, eid, bindingPrivateData,
-                        this](boost::asio::yield_context yield) mutable {
+    auto sendEntries = [entries = entries, eid, bindingPrivateData,
+                        this]() mutable -> boost::asio::awaitable<void> {
         std::vector<uint8_t> req = formatRoutingInfoUpdateCommand(entries);
         std::vector<uint8_t> resp;
 
@@ -771,17 +829,17 @@ void MCTPBridge::sendRoutingTableEntries(
             {
                 phosphor::logging::log<phosphor::logging::level::ERR>(
                     "RoutingInfoUpdate: Unable to find EID");
-                return;
+                co_return;
             }
         }
 
         if (PacketState::receivedResponse !=
-            sendAndRcvMctpCtrl(yield, req, eid, bindingPrivateData.value(),
-                               resp))
+            co_await sendAndRcvMctpCtrl(req, eid, bindingPrivateData.value(),
+                                        resp))
         {
             phosphor::logging::log<phosphor::logging::level::ERR>(
                 "RoutingInfoUpdate: Unable to get response");
-            return;
+            co_return;
         }
 
         if (!checkRespSizeAndCompletionCode<mctp_ctrl_resp_routing_info_update>(
@@ -790,7 +848,8 @@ void MCTPBridge::sendRoutingTableEntries(
             phosphor::logging::log<phosphor::logging::level::ERR>(
                 "RoutingInfoUpdate: Unsuccesful response received");
         }
-    });
+    };
+    boost::asio::co_spawn(io, std::move(sendEntries), boost::asio::detached);
 }
 
 void MCTPBridge::sendNewRoutingTableEntryToAllBridges(
@@ -813,7 +872,7 @@ void MCTPBridge::sendNewRoutingTableEntryToAllBridges(
 }
 
 void MCTPBridge::sendRoutingTableEntriesToBridge(
-    const mctp_eid_t bridge, const std::vector<uint8_t>& bindingPrivate)
+    const mctp_eid_t bridge, const mctpd::BindingPrivate& bindingPrivate)
 {
     auto& routingTableEntries = this->routingTable.getAllEntries();
     std::vector<RoutingTableEntry::MCTPLibData> libmctpEntries;
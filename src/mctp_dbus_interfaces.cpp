@@ -54,12 +54,22 @@ MCTPDBusInterfaces::~MCTPDBusInterfaces()
     {
         objectServer->remove_interface(iter.second);
     }
+    for (auto& iter : transportInterface)
+    {
+        objectServer->remove_interface(iter.second);
+    }
 
     objectServer->remove_interface(mctpInterface);
 }
 
 void MCTPDBusInterfaces::populateDeviceProperties(const mctp_eid_t,
-                                                  const std::vector<uint8_t>&)
+                                                  const mctpd::BindingPrivate&)
+{
+    // Do nothing
+}
+
+void MCTPDBusInterfaces::populateTransportProperties(
+    std::shared_ptr<dbus_interface>&, const mctp_eid_t)
 {
     // Do nothing
 }
@@ -118,6 +128,50 @@ void MCTPDBusInterfaces::populateEndpointProperties(
     uuidIntf->initialize();
     uuidInterface.emplace(epProperties.endpointEid, std::move(uuidIntf));
 
+    populateVendorIdProperties(mctpEpObj, epProperties);
+
+    // Location code interface
+    std::shared_ptr<dbus_interface> locationCodeIntf;
+    locationCodeIntf = objectServer->add_interface(
+        mctpEpObj, LocationCodeDecorator::interface);
+    locationCodeIntf->register_property("LocationCode",
+                                        epProperties.locationCode);
+    locationCodeIntf->initialize();
+    locationCodeInterface.emplace(epProperties.endpointEid,
+                                  std::move(locationCodeIntf));
+
+    // Transport interface
+    std::shared_ptr<dbus_interface> transportIntf;
+    transportIntf = objectServer->add_interface(
+        mctpEpObj, "xyz.openbmc_project.MCTP.Transport");
+    populateTransportProperties(transportIntf, epProperties.endpointEid);
+    transportIntf->initialize();
+    transportInterface.emplace(epProperties.endpointEid,
+                               std::move(transportIntf));
+
+    // Message type interface
+    // This interface should be added last as adding it will trigger mctpwplus
+    // deviceAdded event
+    populateMsgTypeProperties(mctpEpObj, epProperties);
+}
+
+void MCTPDBusInterfaces::updateCapabilityProperties(
+    const EndpointProperties& epProperties)
+{
+    std::string mctpEpObj = "/xyz/openbmc_project/mctp/device/" +
+                            std::to_string(epProperties.endpointEid);
+
+    // Message type interface is added again, so that mctpwplus clients get
+    // deviceAdded event with the new capabilities
+    removeInterface(epProperties.endpointEid, msgTypeInterface);
+    removeInterface(epProperties.endpointEid, vendorIdInterface);
+    populateVendorIdProperties(mctpEpObj, epProperties);
+    populateMsgTypeProperties(mctpEpObj, epProperties);
+}
+
+void MCTPDBusInterfaces::populateVendorIdProperties(
+    const std::string& mctpEpObj, const EndpointProperties& epProperties)
+{
     // Vendor-defined message type interface
     if (epProperties.endpointMsgTypes.vdpci)
     {
@@ -132,20 +186,11 @@ void MCTPDBusInterfaces::populateEndpointProperties(
         vendorIdInterface.emplace(epProperties.endpointEid,
                                   std::move(vendorIdIntf));
     }
+}
 
-    // Location code interface
-    std::shared_ptr<dbus_interface> locationCodeIntf;
-    locationCodeIntf = objectServer->add_interface(
-        mctpEpObj, LocationCodeDecorator::interface);
-    locationCodeIntf->register_property("LocationCode",
-                                        epProperties.locationCode);
-    locationCodeIntf->initialize();
-    locationCodeInterface.emplace(epProperties.endpointEid,
-                                  std::move(locationCodeIntf));
-
-    // Message type interface
-    // This interface should be added last as adding it will trigger mctpwplus
-    // deviceAdded event
+void MCTPDBusInterfaces::populateMsgTypeProperties(
+    const std::string& mctpEpObj, const EndpointProperties& epProperties)
+{
     std::shared_ptr<dbus_interface> msgTypeIntf;
     msgTypeIntf =
         objectServer->add_interface(mctpEpObj, mctp_msg_types::interface);
@@ -16,11 +16,12 @@
 
 #include "mctp_device.hpp"
 
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <phosphor-logging/log.hpp>
 
 #include "libmctp-msgtypes.h"
 
-constexpr unsigned int ctrlTxPollInterval = 5;
 // Supported MCTP Version 1.3.1
 struct MCTPVersionFields supportedMCTPVersion = {241, 243, 241, 0};
 
@@ -38,10 +39,13 @@ MCTPDevice::MCTPDevice(boost::asio::io_context& ioc,
         throw std::system_error(
             std::make_error_code(std::errc::not_enough_memory));
     }
+    releaseObserverId = correlator->addReleaseObserver(
+        [this](mctp_eid_t eid) { onTagReleased(eid); });
 }
 
 MCTPDevice::~MCTPDevice()
 {
+    correlator->removeReleaseObserver(releaseObserverId);
     if (mctp)
     {
         mctp_destroy(mctp);
@@ -66,29 +70,35 @@ void MCTPDevice::initializeLogging(void)
     }
 }
 
-std::optional<std::vector<uint8_t>>
+std::optional<mctpd::BindingPrivate>
     MCTPDevice::getBindingPrivateData(uint8_t /*dstEid*/)
 {
     // No Binding data by default
-    return std::vector<uint8_t>();
+    return mctpd::BindingPrivate();
 }
 
 std::optional<std::string>
-    MCTPDevice::getLocationCode(const std::vector<uint8_t>&)
+    MCTPDevice::getLocationCode(const mctpd::BindingPrivate&)
 {
     return std::nullopt;
 }
 
 void MCTPDevice::updateRoutingTableEntry(mctpd::RoutingTable::Entry,
-                                         const std::vector<uint8_t>&)
+                                         const mctpd::BindingPrivate&)
 {
     // Do nothing
 }
 
+bool MCTPDevice::isPipelinedRegistrationAllowed(const mctpd::BindingPrivate&)
+{
+    // Registration queries are sent one after another by default
+    return false;
+}
+
 bool MCTPDevice::sendMctpCtrlMessage(mctp_eid_t destEid,
-                                     std::vector<uint8_t> req, bool tagOwner,
+                                     CtrlReqBuffer& req, bool tagOwner,
                                      uint8_t msgTag,
-                                     std::vector<uint8_t> bindingPrivate)
+                                     mctpd::BindingPrivate& bindingPrivate)
 {
     if (mctp_message_tx(mctp, destEid, req.data(), req.size(), tagOwner, msgTag,
                         bindingPrivate.data()) < 0)
@@ -97,6 +107,7 @@ bool MCTPDevice::sendMctpCtrlMessage(mctp_eid_t destEid,
             "MCTP control: mctp_message_tx failed");
         return false;
     }
+    ++ctrlRequestsSent;
     return true;
 }
 
@@ -105,61 +116,179 @@ static uint8_t getInstanceId(const uint8_t msg)
     return msg & MCTP_CTRL_HDR_INSTANCE_ID_MASK;
 }
 
-bool MCTPDevice::handleCtrlResp(void* msg, const size_t len)
+MCTPDevice::CtrlTxKey MCTPDevice::getCtrlTxKey(mctp_eid_t eid,
+                                               uint8_t msgTag)
+{
+    return static_cast<CtrlTxKey>(eid << 3 | (msgTag & MCTP_HDR_TAG_MASK));
+}
+
+void MCTPDevice::removeCtrlTransaction(
+    std::unordered_map<CtrlTxKey, CtrlTransaction>::iterator it)
+{
+    const auto& transaction = it->second;
+    correlator->forget(transaction.destEid, transaction.msgTag);
+    correlator->releaseTag(transaction.destEid, transaction.msgTag);
+    instanceIds.release(transaction.destEid, transaction.instanceId);
+    ctrlTxDeadlines.erase(transaction.deadline);
+    ctrlTxTable.erase(it);
+}
+
+/*
+ * Called by correlator for responses carrying message terminus of the
+ * request. Response which is not a control response with the instance ID
+ * of the request leaves request pending.
+ */
+bool MCTPDevice::handleCtrlResp(CtrlTxKey key,
+                                std::span<const uint8_t> response)
 {
-    mctp_ctrl_msg_hdr* respHeader = reinterpret_cast<mctp_ctrl_msg_hdr*>(msg);
+    auto reqItr = ctrlTxTable.find(key);
+    if (reqItr == ctrlTxTable.end())
+    {
+        return false;
+    }
 
-    auto reqItr =
-        std::find_if(ctrlTxQueue.begin(), ctrlTxQueue.end(), [&](auto& ctrlTx) {
-            auto& [state, retryCount, maxRespDelay, destEid, bindingPrivate,
-                   req, callback] = ctrlTx;
+    void* msg = const_cast<uint8_t*>(response.data());
+    if (!mctp_is_mctp_ctrl_msg(msg, response.size()) ||
+        mctp_ctrl_msg_is_req(msg, response.size()) ||
+        getInstanceId(response[1]) != reqItr->second.instanceId)
+    {
+        phosphor::logging::log<phosphor::logging::level::WARNING>(
+            "No matching Control command request found for the response");
+        return false;
+    }
 
-            mctp_ctrl_msg_hdr* reqHeader =
-                reinterpret_cast<mctp_ctrl_msg_hdr*>(req.data());
+    phosphor::logging::log<phosphor::logging::level::DEBUG>(
+        "Matching Control command request found");
 
-            if (!reqHeader)
+    // Response to retransmitted request may belong to any of the attempts
+    if (reqItr->second.attempt == 0)
+    {
+        addRttSample(reqItr->second.destEid,
+                     std::chrono::duration_cast<std::chrono::microseconds>(
+                         std::chrono::steady_clock::now() -
+                         reqItr->second.sentAt));
+    }
+
+    // Delete the entry from table before calling callback
+    auto callback = std::move(reqItr->second.callback);
+    removeCtrlTransaction(reqItr);
+    armCtrlTxTimer();
+
+    std::vector<uint8_t> resp(response.begin(), response.end());
+    callback(PacketState::receivedResponse, resp);
+    return true;
+}
+
+/*
+ * Handles requests whose deadline passed. Request still having retries left
+ * before its policy deadline is transmitted again and gets next deadline,
+ * others complete with no response.
+ */
+void MCTPDevice::processCtrlTxQueue()
+{
+    const auto now = std::chrono::steady_clock::now();
+    std::vector<CtrlTxCallback> expired;
+
+    while (!ctrlTxDeadlines.empty() && ctrlTxDeadlines.begin()->first <= now)
+    {
+        auto reqItr = ctrlTxTable.find(ctrlTxDeadlines.begin()->second);
+        auto& transaction = reqItr->second;
+        addRttTimeout(transaction.destEid);
+
+        // Total no of tries = 1 + retryCount
+        if (transaction.attempt < transaction.policy.retryCount &&
+            (!transaction.expiry || now < *transaction.expiry))
+        {
+            if (sendMctpCtrlMessage(transaction.destEid, transaction.req, true,
+                                    transaction.msgTag,
+                                    transaction.bindingPrivate))
             {
                 phosphor::logging::log<phosphor::logging::level::DEBUG>(
-                    "MCTP Control Request Header is null");
-                return false;
+                    "Packet transmited");
             }
 
-            // TODO: Check Message terminus with Instance ID
-            // (EID, TO, Msg Tag) + Instance ID
-            if (getInstanceId(reqHeader->rq_dgram_inst) ==
-                getInstanceId(respHeader->rq_dgram_inst))
+            transaction.attempt++;
+            auto deadline =
+                transaction.deadline->first +
+                transaction.policy.getTimeout(transaction.attempt, retryJitter);
+            if (transaction.expiry)
             {
-                phosphor::logging::log<phosphor::logging::level::DEBUG>(
-                    "Matching Control command request found");
+                deadline = std::min(deadline, *transaction.expiry);
+            }
+            ctrlTxDeadlines.erase(transaction.deadline);
+            transaction.deadline =
+                ctrlTxDeadlines.emplace(deadline, reqItr->first);
+            continue;
+        }
 
-                uint8_t* tmp = reinterpret_cast<uint8_t*>(msg);
-                std::vector<uint8_t> resp =
-                    std::vector<uint8_t>(tmp, tmp + len);
-                state = PacketState::receivedResponse;
+        phosphor::logging::log<phosphor::logging::level::DEBUG>(
+            "Retry timed out, No response");
+        expired.emplace_back(std::move(transaction.callback));
+        removeCtrlTransaction(reqItr);
+    }
 
-                // Call Callback function
-                callback(state, resp);
-                return true;
-            }
-            return false;
-        });
+    for (auto it = ctrlTagWaiters.begin(); it != ctrlTagWaiters.end();)
+    {
+        if (it->expiry > now)
+        {
+            ++it;
+            continue;
+        }
+        phosphor::logging::log<phosphor::logging::level::DEBUG>(
+            "No message tag released before expiry, No response",
+            phosphor::logging::entry("EID=%d", it->destEid));
+        expired.emplace_back(std::move(it->callback));
+        it = ctrlTagWaiters.erase(it);
+    }
 
-    if (reqItr != ctrlTxQueue.end())
+    // Callbacks run after table is consistent, they may push new requests
+    for (auto& callback : expired)
     {
-        // Delete the entry from queue after receiving response
-        ctrlTxQueue.erase(reqItr);
-        return true;
+        std::vector<uint8_t> resp1 = {};
+        callback(PacketState::noResponse, resp1);
     }
 
-    phosphor::logging::log<phosphor::logging::level::WARNING>(
-        "No matching Control command request found for the response");
-    return false;
+    armCtrlTxTimer();
 }
 
-void MCTPDevice::processCtrlTxQueue()
+/*
+ * Keeps ctrlTxTimer armed to the earliest deadline of pending requests and
+ * requests waiting for a tag, idle when there are none
+ */
+void MCTPDevice::armCtrlTxTimer()
 {
-    ctrlTxTimerExpired = false;
-    ctrlTxTimer.expires_after(std::chrono::milliseconds(ctrlTxPollInterval));
+    std::optional<std::chrono::steady_clock::time_point> earliest;
+    if (!ctrlTxDeadlines.empty())
+    {
+        earliest = ctrlTxDeadlines.begin()->first;
+    }
+    for (const auto& waiter : ctrlTagWaiters)
+    {
+        if (!earliest || waiter.expiry < *earliest)
+        {
+            earliest = waiter.expiry;
+        }
+    }
+
+    if (!earliest)
+    {
+        if (ctrlTxTimerExpiry)
+        {
+            ctrlTxTimerExpiry.reset();
+            ctrlTxTimer.cancel();
+            phosphor::logging::log<phosphor::logging::level::DEBUG>(
+                "ctrlTxTable empty, canceling timer");
+        }
+        return;
+    }
+
+    if (ctrlTxTimerExpiry == earliest)
+    {
+        return;
+    }
+
+    ctrlTxTimerExpiry = earliest;
+    ctrlTxTimer.expires_at(*earliest);
     ctrlTxTimer.async_wait([this](const boost::system::error_code& ec) {
         if (ec == boost::asio::error::operation_aborted)
         {
@@ -175,135 +304,282 @@ void MCTPDevice::processCtrlTxQueue()
             return;
         }
 
-        // Discard the packet if retry count exceeded
-
-        ctrlTxQueue.erase(
-            std::remove_if(
-                ctrlTxQueue.begin(), ctrlTxQueue.end(),
-                [this](auto& ctrlTx) {
-                    auto& [state, retryCount, maxRespDelay, destEid,
-                           bindingPrivate, req, callback] = ctrlTx;
-
-                    maxRespDelay -= ctrlTxPollInterval;
-
-                    // If no reponse:
-                    // Retry the packet on every ctrlTxRetryDelay
-                    // Total no of tries = 1 + ctrlTxRetryCount
-                    if (maxRespDelay > 0 &&
-                        state != PacketState::receivedResponse)
-                    {
-                        if (retryCount > 0 &&
-                            maxRespDelay <= retryCount * ctrlTxRetryDelay)
-                        {
-                            if (sendMctpCtrlMessage(destEid, req, true, 0,
-                                                    bindingPrivate))
-                            {
-                                phosphor::logging::log<
-                                    phosphor::logging::level::DEBUG>(
-                                    "Packet transmited");
-                                state = PacketState::transmitted;
-                            }
-
-                            // Decrement retry count
-                            retryCount--;
-                        }
-
-                        return false;
-                    }
-
-                    state = PacketState::noResponse;
-                    std::vector<uint8_t> resp1 = {};
-                    phosphor::logging::log<phosphor::logging::level::DEBUG>(
-                        "Retry timed out, No response");
-
-                    // Call Callback function
-                    callback(state, resp1);
-                    return true;
-                }),
-            ctrlTxQueue.end());
-
-        if (ctrlTxQueue.empty())
+        ctrlTxTimerExpiry.reset();
+        processCtrlTxQueue();
+    });
+}
+
+bool MCTPDevice::pushToCtrlTxQueue(const mctp_eid_t destEid,
+                                   const mctpd::BindingPrivate& bindingPrivate,
+                                   std::span<const uint8_t> req,
+                                   CtrlTxCallback&& callback)
+{
+    const std::optional<uint8_t> instanceId = instanceIds.allocate(destEid);
+    if (!instanceId)
+    {
+        phosphor::logging::log<phosphor::logging::level::ERR>(
+            "No free instance ID for control request",
+            phosphor::logging::entry("EID=%d", destEid));
+        return false;
+    }
+
+    const auto* header = reinterpret_cast<const mctp_ctrl_msg_hdr*>(req.data());
+    mctpd::RetryPolicy policy =
+        getRetryPolicy(getCtrlCommandClass(header->command_code));
+    if (adaptiveTimeouts)
+    {
+        if (auto estimate = rttEstimator.getEstimate(destEid))
         {
-            ctrlTxTimer.cancel();
-            ctrlTxTimerExpired = true;
-            phosphor::logging::log<phosphor::logging::level::DEBUG>(
-                "ctrlTxQueue empty, canceling timer");
+            policy.timeout = estimate->timeout;
         }
-        else
+    }
+    const auto now = std::chrono::steady_clock::now();
+
+    // Tags are shared with upper layer messages sent to the same EID, and
+    // tags of null EID with every registration in progress
+    const std::optional<uint8_t> msgTag = correlator->allocateTag(destEid);
+    if (!msgTag)
+    {
+        instanceIds.release(destEid, *instanceId);
+        phosphor::logging::log<phosphor::logging::level::DEBUG>(
+            "No free message tag, control request waits for one",
+            phosphor::logging::entry("EID=%d", destEid));
+        // Waits no longer than the request would take with all retries
+        std::chrono::milliseconds lifetime = policy.deadline;
+        if (lifetime.count() == 0)
         {
-            processCtrlTxQueue();
+            for (unsigned int attempt = 0; attempt <= policy.retryCount;
+                 attempt++)
+            {
+                lifetime += policy.getTimeout(attempt, retryJitter);
+            }
         }
-    });
-}
+        ctrlTagWaiters.push_back(CtrlTagWaiter{
+            now + lifetime, destEid, bindingPrivate,
+            CtrlReqBuffer(req.begin(), req.end()), std::move(callback)});
+        armCtrlTxTimer();
+        return true;
+    }
 
-void MCTPDevice::pushToCtrlTxQueue(
-    PacketState state, const mctp_eid_t destEid,
-    const std::vector<uint8_t>& bindingPrivate, const std::vector<uint8_t>& req,
-    std::function<void(PacketState, std::vector<uint8_t>&)>& callback)
-{
-    ctrlTxQueue.push_back(std::make_tuple(
-        state, ctrlTxRetryCount, ((ctrlTxRetryCount + 1) * ctrlTxRetryDelay),
-        destEid, bindingPrivate, req, callback));
+    std::optional<std::chrono::steady_clock::time_point> expiry;
+    if (policy.deadline.count() > 0)
+    {
+        expiry = now + policy.deadline;
+    }
+
+    const CtrlTxKey key = getCtrlTxKey(destEid, *msgTag);
+    auto [reqItr, inserted] = ctrlTxTable.try_emplace(
+        key, policy, 0, now, ctrlTxDeadlines.end(), expiry, destEid, *msgTag,
+        *instanceId, bindingPrivate, CtrlReqBuffer(req.begin(), req.end()),
+        std::move(callback));
+    if (!inserted)
+    {
+        correlator->releaseTag(destEid, *msgTag);
+        instanceIds.release(destEid, *instanceId);
+        phosphor::logging::log<phosphor::logging::level::ERR>(
+            "Control request with the same tag is already pending",
+            phosphor::logging::entry("EID=%d", destEid),
+            phosphor::logging::entry("TAG=%d", *msgTag));
+        return false;
+    }
+    correlator->expect(destEid, *msgTag,
+                       [this, key](std::span<const uint8_t> response) {
+                           return handleCtrlResp(key, response);
+                       });
+
+    auto& transaction = reqItr->second;
+    auto* reqHeader =
+        reinterpret_cast<mctp_ctrl_msg_hdr*>(transaction.req.data());
+    reqHeader->rq_dgram_inst =
+        static_cast<uint8_t>(MCTP_CTRL_HDR_FLAG_REQUEST | *instanceId);
+    auto deadline = now + policy.getTimeout(0, retryJitter);
+    if (expiry)
+    {
+        deadline = std::min(deadline, *expiry);
+    }
+    transaction.deadline = ctrlTxDeadlines.emplace(deadline, key);
 
-    if (sendMctpCtrlMessage(destEid, req, true, 0, bindingPrivate))
+    if (sendMctpCtrlMessage(destEid, transaction.req, true, *msgTag,
+                            transaction.bindingPrivate))
     {
         phosphor::logging::log<phosphor::logging::level::DEBUG>(
             "Packet transmited");
-        state = PacketState::transmitted;
     }
 
-    if (ctrlTxTimerExpired)
+    armCtrlTxTimer();
+    return true;
+}
+
+void MCTPDevice::onTagReleased(mctp_eid_t eid)
+{
+    if (std::none_of(ctrlTagWaiters.begin(), ctrlTagWaiters.end(),
+                     [eid](const CtrlTagWaiter& waiter) {
+                         return waiter.destEid == eid;
+                     }))
     {
-        processCtrlTxQueue();
+        return;
     }
+    // Tag is released from within completion of its request
+    boost::asio::post(io, [this, eid] { sendCtrlTagWaiter(eid); });
 }
 
-PacketState MCTPDevice::sendAndRcvMctpCtrl(
-    boost::asio::yield_context& yield, const std::vector<uint8_t>& req,
-    const mctp_eid_t destEid, const std::vector<uint8_t>& bindingPrivate,
-    std::vector<uint8_t>& resp)
+void MCTPDevice::sendCtrlTagWaiter(mctp_eid_t eid)
 {
-    if (req.empty())
+    auto it = std::find_if(
+        ctrlTagWaiters.begin(), ctrlTagWaiters.end(),
+        [eid](const CtrlTagWaiter& waiter) { return waiter.destEid == eid; });
+    if (it == ctrlTagWaiters.end() || !correlator->hasFreeTag(eid))
     {
-        return PacketState::invalidPacket;
+        return;
     }
 
-    PacketState pktState = PacketState::pushedForTransmission;
-    boost::system::error_code ec;
-    boost::asio::steady_timer timer(io);
+    CtrlTagWaiter waiter = std::move(*it);
+    ctrlTagWaiters.erase(it);
+    if (!pushToCtrlTxQueue(
+            waiter.destEid, waiter.bindingPrivate,
+            std::span<const uint8_t>(waiter.req.data(), waiter.req.size()),
+            std::move(waiter.callback)))
+    {
+        std::vector<uint8_t> response{};
+        waiter.callback(PacketState::invalidPacket, response);
+    }
+}
 
-    std::function<void(PacketState, std::vector<uint8_t>&)> callback =
-        [&resp, &pktState, &timer](PacketState state,
-                                   std::vector<uint8_t>& response) {
-            phosphor::logging::log<phosphor::logging::level::DEBUG>(
-                "Callback triggered");
+// Requests to null or broadcast EID are answered by unknown endpoints
+static bool isRttTracked(mctp_eid_t eid)
+{
+    return eid != MCTP_EID_NULL && eid != MCTP_EID_BROADCAST;
+}
 
-            resp = response;
-            pktState = state;
-            timer.cancel();
+void MCTPDevice::addRttSample(mctp_eid_t eid, std::chrono::microseconds rtt)
+{
+    if (!isRttTracked(eid))
+    {
+        return;
+    }
+    const auto previous = rttEstimator.getEstimate(eid);
+    rttEstimator.addSample(eid, rtt);
+    publishRttEstimate(eid, previous);
+}
 
-            phosphor::logging::log<phosphor::logging::level::DEBUG>(
-                ("Packet state: " + std::to_string(static_cast<int>(pktState)))
-                    .c_str());
-        };
+void MCTPDevice::addRttTimeout(mctp_eid_t eid)
+{
+    if (!isRttTracked(eid))
+    {
+        return;
+    }
+    const auto previous = rttEstimator.getEstimate(eid);
+    rttEstimator.addTimeout(eid);
+    publishRttEstimate(eid, previous);
+}
 
-    pushToCtrlTxQueue(pktState, destEid, bindingPrivate, req, callback);
+// Only properties whose value changed are set, each of them emits a signal
+void MCTPDevice::publishRttEstimate(
+    mctp_eid_t eid,
+    const std::optional<mctpd::RttEstimator::Estimate>& previous)
+{
+    auto it = transportInterface.find(eid);
+    auto estimate = rttEstimator.getEstimate(eid);
+    if (it == transportInterface.end() || !estimate)
+    {
+        return;
+    }
 
-    // Wait for the state to change
-    while (pktState == PacketState::pushedForTransmission)
+    if (!previous || previous->timeout != estimate->timeout)
     {
-        timer.expires_after(std::chrono::milliseconds(ctrlTxRetryDelay));
-        phosphor::logging::log<phosphor::logging::level::DEBUG>(
-            "sendAndRcvMctpCtrl: Timer created, ctrl cmd waiting");
-        timer.async_wait(yield[ec]);
-        if (ec && ec != boost::asio::error::operation_aborted)
-        {
-            phosphor::logging::log<phosphor::logging::level::ERR>(
-                "sendAndRcvMctpCtrl: async_wait error");
-        }
+        it->second->set_property(
+            "RetransmissionTimeoutMs",
+            static_cast<uint64_t>(estimate->timeout.count()));
+    }
+    if (!previous || previous->smoothedRtt != estimate->smoothedRtt)
+    {
+        it->second->set_property(
+            "SmoothedRoundTripTimeUs",
+            static_cast<uint64_t>(estimate->smoothedRtt.count()));
+    }
+    if (!previous || previous->rttVariance != estimate->rttVariance)
+    {
+        it->second->set_property(
+            "RoundTripTimeVarianceUs",
+            static_cast<uint64_t>(estimate->rttVariance.count()));
+    }
+}
+
+mctpd::CtrlCommandClass MCTPDevice::getCtrlCommandClass(uint8_t commandCode)
+{
+    switch (commandCode)
+    {
+        case MCTP_CTRL_CMD_SET_ENDPOINT_ID:
+        case MCTP_CTRL_CMD_GET_ENDPOINT_ID:
+        case MCTP_CTRL_CMD_GET_ENDPOINT_UUID:
+        case MCTP_CTRL_CMD_GET_VERSION_SUPPORT:
+        case MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT:
+        case MCTP_CTRL_CMD_GET_VENDOR_MESSAGE_SUPPORT:
+        case MCTP_CTRL_CMD_PREPARE_ENDPOINT_DISCOVERY:
+        case MCTP_CTRL_CMD_ENDPOINT_DISCOVERY:
+        case MCTP_CTRL_CMD_DISCOVERY_NOTIFY:
+            return mctpd::CtrlCommandClass::discovery;
+        case MCTP_CTRL_CMD_GET_ROUTING_TABLE_ENTRIES:
+            return mctpd::CtrlCommandClass::routingTablePolling;
+        case MCTP_CTRL_CMD_ROUTING_INFO_UPDATE:
+            return mctpd::CtrlCommandClass::routingInfoUpdate;
+        default:
+            return mctpd::CtrlCommandClass::general;
+    }
+}
+
+mctpd::RetryPolicy
+    MCTPDevice::getRetryPolicy(mctpd::CtrlCommandClass commandClass) const
+{
+    auto it = ctrlRetryPolicies.find(commandClass);
+    if (it != ctrlRetryPolicies.end())
+    {
+        return it->second;
     }
 
-    return pktState;
+    // Fixed timeout and retry count of binding configuration
+    mctpd::RetryPolicy policy;
+    policy.timeout = std::chrono::milliseconds(ctrlTxRetryDelay);
+    policy.retryCount = ctrlTxRetryCount;
+    return policy;
+}
+
+boost::system::error_code MCTPDevice::getCtrlTxErrorCode(PacketState state)
+{
+    switch (state)
+    {
+        case PacketState::receivedResponse:
+            return {};
+        case PacketState::noResponse:
+            return boost::asio::error::timed_out;
+        default:
+            return boost::asio::error::invalid_argument;
+    }
+}
+
+boost::asio::awaitable<PacketState> MCTPDevice::sendAndRcvMctpCtrl(
+    std::span<const uint8_t> req, const mctp_eid_t destEid,
+    const mctpd::BindingPrivate& bindingPrivate, std::vector<uint8_t>& resp)
+{
+    boost::system::error_code ec;
+    resp = co_await asyncSendAndRcvMctpCtrl(
+        req, destEid, bindingPrivate,
+        boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+    phosphor::logging::log<phosphor::logging::level::DEBUG>(
+        "sendAndRcvMctpCtrl: completed",
+        phosphor::logging::entry("EID=%d", destEid),
+        phosphor::logging::entry("ERROR=%s", ec.message().c_str()));
+
+    if (!ec)
+    {
+        co_return PacketState::receivedResponse;
+    }
+    if (ec == boost::asio::error::timed_out)
+    {
+        co_return PacketState::noResponse;
+    }
+    co_return PacketState::invalidPacket;
 }
 
 mctp_server::BindingModeTypes MCTPDevice::getEndpointType(const uint8_t types)
@@ -332,7 +608,7 @@ mctp_server::BindingModeTypes MCTPDevice::getEndpointType(const uint8_t types)
     }
 }
 
-MsgTypes MCTPDevice::getMsgTypes(const std::vector<uint8_t>& msgType)
+MsgTypes MCTPDevice::getMsgTypes(std::span<const uint8_t> msgType)
 {
     MsgTypes messageTypes;
 
@@ -464,6 +740,9 @@ void MCTPDevice::unregisterEndpoint(mctp_eid_t eid)
     removeInterface(eid, vendorIdInterface);
     removeInterface(eid, locationCodeInterface);
     removeInterface(eid, deviceInterface);
+    removeInterface(eid, transportInterface);
+    rttEstimator.forget(eid);
+    circuitBreaker.forget(eid);
 
     if (epIntf && msgTypeIntf && uuidIntf)
     {
@@ -293,36 +293,35 @@ bool MCTPEndpoint::handleGetRoutingTable(const std::vector<uint8_t>& request,
     return status;
 }
 
-bool MCTPEndpoint::discoveryNotifyCtrlCmd(
-    boost::asio::yield_context& yield,
-    const std::vector<uint8_t>& bindingPrivate, const mctp_eid_t destEid)
+boost::asio::awaitable<bool> MCTPEndpoint::discoveryNotifyCtrlCmd(
+    const mctpd::BindingPrivate& bindingPrivate, const mctp_eid_t destEid)
 {
-    std::vector<uint8_t> req = {};
     std::vector<uint8_t> resp = {};
 
-    if (!getFormattedReq<MCTP_CTRL_CMD_DISCOVERY_NOTIFY>(req))
+    auto req = getFormattedReq<MCTP_CTRL_CMD_DISCOVERY_NOTIFY>();
+    if (!req)
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Discovery Notify: Request formatting failed");
-        return false;
+        co_return false;
     }
 
     if (PacketState::receivedResponse !=
-        sendAndRcvMctpCtrl(yield, req, destEid, bindingPrivate, resp))
+        co_await sendAndRcvMctpCtrl(*req, destEid, bindingPrivate, resp))
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Discovery Notify: Unable to get response");
-        return false;
+        co_return false;
     }
 
     if (!checkRespSizeAndCompletionCode<mctp_ctrl_resp_discovery_notify>(resp))
     {
         phosphor::logging::log<phosphor::logging::level::ERR>(
             "Discovery Notify failed");
-        return false;
+        co_return false;
     }
 
     phosphor::logging::log<phosphor::logging::level::INFO>(
         "Discovery Notify success");
-    return true;
+    co_return true;
 }
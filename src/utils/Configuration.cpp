@@ -2,6 +2,7 @@
 
 #include "utils/types.hpp"
 
+#include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <fstream>
 #include <memory>
@@ -122,6 +123,14 @@ static bool getField(const json& configuration, const std::string& fieldName,
     }
 }
 
+// Optional fields keep their defaults without warning when missing
+template <typename T, typename V>
+static bool getOptionalField(const T& map, const std::string& fieldName,
+                             V& value)
+{
+    return map.contains(fieldName) && getField(map, fieldName, value);
+}
+
 template <typename T>
 std::set<std::string> getAllowedBuses(const T& map)
 {
@@ -139,6 +148,199 @@ std::set<std::string> getAllowedBuses(const T& map)
     return std::set<std::string>(allowedBuses.begin(), allowedBuses.end());
 }
 
+template <typename T>
+static void getTransmissionQueueConfiguration(const T& map,
+                                              Configuration& config)
+{
+    std::vector<uint64_t> weightEids;
+    std::vector<uint64_t> weights;
+    uint64_t maxInFlight = 0;
+    std::vector<uint64_t> priorityMessageTypes;
+    uint64_t starvationTimeoutMs = 0;
+    uint64_t maxQueuedPerEid = 0;
+    uint64_t maxQueued = 0;
+    uint64_t txRetryCount = 0;
+    uint64_t txRetryDelayMs = 0;
+    uint64_t tagQuarantineMs = 0;
+    uint64_t initialWindow = 0;
+    uint64_t breakerThreshold = 0;
+    uint64_t breakerProbeIntervalMs = 0;
+
+    if (getOptionalField(map, "EndpointWeightEIDs", weightEids) &&
+        getOptionalField(map, "EndpointWeights", weights))
+    {
+        if (weightEids.size() != weights.size())
+        {
+            phosphor::logging::log<phosphor::logging::level::ERR>(
+                "EndpointWeightEIDs and EndpointWeights differ in size. "
+                "Endpoint weights will be ignored");
+        }
+        else
+        {
+            for (size_t i = 0; i < weightEids.size(); i++)
+            {
+                config.endpointWeights.emplace(
+                    static_cast<uint8_t>(weightEids[i]),
+                    static_cast<unsigned int>(weights[i]));
+            }
+        }
+    }
+
+    if (getOptionalField(map, "MaxInFlightMessages", maxInFlight))
+    {
+        config.maxInFlightMessages = static_cast<unsigned int>(maxInFlight);
+    }
+
+    // Message types listed from the highest priority
+    if (getOptionalField(map, "PriorityMessageTypes", priorityMessageTypes))
+    {
+        for (uint64_t msgType : priorityMessageTypes)
+        {
+            config.priorityMessageTypes.push_back(
+                static_cast<uint8_t>(msgType));
+        }
+    }
+
+    if (getOptionalField(map, "StarvationTimeoutMs", starvationTimeoutMs))
+    {
+        config.starvationTimeoutMs =
+            static_cast<unsigned int>(starvationTimeoutMs);
+    }
+
+    // 0 disables given queue limit
+    if (getOptionalField(map, "MaxQueuedMessagesPerEID", maxQueuedPerEid))
+    {
+        config.maxQueuedMessagesPerEid =
+            static_cast<unsigned int>(maxQueuedPerEid);
+    }
+
+    if (getOptionalField(map, "MaxQueuedMessages", maxQueued))
+    {
+        config.maxQueuedMessages = static_cast<unsigned int>(maxQueued);
+    }
+
+    // Retransmission of messages which binding failed to send
+    if (getOptionalField(map, "TxRetryCount", txRetryCount))
+    {
+        config.txRetryCount = static_cast<unsigned int>(txRetryCount);
+    }
+
+    if (getOptionalField(map, "TxRetryDelayMs", txRetryDelayMs))
+    {
+        config.txRetryDelayMs = static_cast<unsigned int>(txRetryDelayMs);
+    }
+
+    // Tags of timed out requests are not reused for that long
+    if (getOptionalField(map, "TagQuarantineMs", tagQuarantineMs))
+    {
+        config.tagQuarantineMs = static_cast<unsigned int>(tagQuarantineMs);
+    }
+
+    getOptionalField(map, "MatchPLDMInstanceID", config.matchPldmInstanceId);
+
+    // Per EID in-flight window, grows on responses and halves on timeouts
+    getOptionalField(map, "AdaptiveInFlightWindow",
+                     config.adaptiveInFlightWindow);
+    if (getOptionalField(map, "InitialInFlightWindow", initialWindow))
+    {
+        config.initialInFlightWindow = static_cast<uint8_t>(initialWindow);
+    }
+
+    // Consecutive timeouts after which requests to EID fail immediately,
+    // 0 disables circuit breaker
+    if (getOptionalField(map, "CircuitBreakerThreshold", breakerThreshold))
+    {
+        config.circuitBreakerThreshold =
+            static_cast<unsigned int>(breakerThreshold);
+    }
+
+    if (getOptionalField(map, "CircuitBreakerProbeIntervalMs",
+                         breakerProbeIntervalMs))
+    {
+        config.circuitBreakerProbeIntervalMs =
+            static_cast<unsigned int>(breakerProbeIntervalMs);
+    }
+
+    getOptionalField(map, "CapabilityCache", config.capabilityCache);
+}
+
+/*
+ * Retry policy of each command class is configured by fields prefixed with
+ * class name, e.g. DiscoveryRetryCount. Missing fields take value of the
+ * general ReqToRespTimeMs and ReqRetryCount, without backoff and jitter.
+ */
+template <typename T>
+static void getRetryPolicyConfiguration(const T& map, Configuration& config)
+{
+    static const std::vector<std::pair<std::string, mctpd::CtrlCommandClass>>
+        commandClasses = {
+            {"Discovery", mctpd::CtrlCommandClass::discovery},
+            {"RoutingTablePolling",
+             mctpd::CtrlCommandClass::routingTablePolling},
+            {"RoutingInfoUpdate", mctpd::CtrlCommandClass::routingInfoUpdate}};
+    static const std::vector<std::string> fields = {
+        "ReqToRespTimeMs",   "RetryCount",         "RetryBackoffFactor",
+        "RetryMaxTimeoutMs", "RetryJitterPercent", "RetryDeadlineMs"};
+
+    for (const auto& [prefix, commandClass] : commandClasses)
+    {
+        uint64_t timeoutMs = config.reqToRespTime;
+        uint64_t retryCount = config.reqRetryCount;
+        uint64_t backoffFactor = 1;
+        uint64_t maxTimeoutMs = 0;
+        uint64_t jitterPercent = 0;
+        uint64_t deadlineMs = 0;
+
+        // Classes without any field are not worth warnings
+        if (std::none_of(fields.begin(), fields.end(),
+                         [&map, &prefix = prefix](const std::string& field) {
+                             return map.contains(prefix + field);
+                         }))
+        {
+            continue;
+        }
+        getField(map, prefix + "ReqToRespTimeMs", timeoutMs);
+        getField(map, prefix + "RetryCount", retryCount);
+        getField(map, prefix + "RetryBackoffFactor", backoffFactor);
+        getField(map, prefix + "RetryMaxTimeoutMs", maxTimeoutMs);
+        getField(map, prefix + "RetryJitterPercent", jitterPercent);
+        getField(map, prefix + "RetryDeadlineMs", deadlineMs);
+
+        mctpd::RetryPolicy policy;
+        policy.timeout = std::chrono::milliseconds(timeoutMs);
+        policy.retryCount = static_cast<uint8_t>(retryCount);
+        policy.backoffFactor =
+            std::max(static_cast<unsigned int>(backoffFactor), 1u);
+        policy.maxTimeout = std::chrono::milliseconds(maxTimeoutMs);
+        policy.jitterPercent = static_cast<unsigned int>(jitterPercent);
+        policy.deadline = std::chrono::milliseconds(deadlineMs);
+        config.ctrlRetryPolicies.insert_or_assign(commandClass, policy);
+    }
+}
+
+template <typename T>
+static void getAdaptiveTimeoutConfiguration(const T& map,
+                                            Configuration& config)
+{
+    uint64_t minTimeoutMs = 0;
+    uint64_t maxTimeoutMs = 0;
+
+    // Round trip time estimate sets first control request timeout
+    getField(map, "AdaptiveTimeouts", config.adaptiveTimeouts);
+    // and caps timeout of SendReceiveMctpMessagePayload callers
+    getField(map, "CapClientTimeouts", config.capClientTimeouts);
+
+    if (getField(map, "AdaptiveTimeoutMinMs", minTimeoutMs))
+    {
+        config.adaptiveTimeoutMinMs = static_cast<unsigned int>(minTimeoutMs);
+    }
+
+    if (getField(map, "AdaptiveTimeoutMaxMs", maxTimeoutMs))
+    {
+        config.adaptiveTimeoutMaxMs = static_cast<unsigned int>(maxTimeoutMs);
+    }
+}
+
 template <typename T>
 static std::optional<SMBusConfiguration> getSMBusConfiguration(const T& map)
 {
@@ -259,8 +461,12 @@ static std::optional<SMBusConfiguration> getSMBusConfiguration(const T& map)
     config.bmcSlaveAddr = static_cast<uint8_t>(bmcReceiverAddress);
     config.reqToRespTime = static_cast<unsigned int>(reqToRespTimeMs);
     config.reqRetryCount = static_cast<uint8_t>(reqRetryCount);
+    getRetryPolicyConfiguration(map, config);
+    getAdaptiveTimeoutConfiguration(map, config);
     config.scanInterval = scanInterval;
+    getField(map, "IncrementalRediscovery", config.incrementalRediscovery);
     config.allowedBuses = getAllowedBuses(map);
+    getTransmissionQueueConfiguration(map, config);
     if (mode != mctp_server::BindingModeTypes::BusOwner)
     {
         config.routingIntervalSec = static_cast<uint8_t>(getRoutingInterval);
@@ -279,6 +485,7 @@ static std::optional<PcieConfiguration> getPcieConfiguration(const T& map)
     uint64_t reqToRespTimeMs;
     uint64_t reqRetryCount;
     uint64_t getRoutingInterval;
+    uint64_t registrationConcurrency;
 
     if (!getField(map, "PhysicalMediumID", physicalMediumID))
     {
@@ -323,11 +530,22 @@ static std::optional<PcieConfiguration> getPcieConfiguration(const T& map)
     config.bdf = static_cast<uint16_t>(bdf);
     config.reqToRespTime = static_cast<unsigned int>(reqToRespTimeMs);
     config.reqRetryCount = static_cast<uint8_t>(reqRetryCount);
+    getRetryPolicyConfiguration(map, config);
+    getAdaptiveTimeoutConfiguration(map, config);
+    getTransmissionQueueConfiguration(map, config);
     if (mode != mctp_server::BindingModeTypes::BusOwner)
     {
         config.getRoutingInterval = static_cast<uint8_t>(getRoutingInterval);
     }
 
+    // 1 registers endpoints found in routing table one after another
+    if (getField(map, "RegistrationConcurrency", registrationConcurrency) &&
+        registrationConcurrency > 0)
+    {
+        config.registrationConcurrency =
+            static_cast<unsigned int>(registrationConcurrency);
+    }
+
     return config;
 }
 
@@ -0,0 +1,381 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "utils/capability_cache.hpp"
+
+#include <algorithm>
+#include <boost/crc.hpp>
+#include <fstream>
+#include <iterator>
+#include <phosphor-logging/log.hpp>
+#include <system_error>
+
+namespace mctpd
+{
+
+namespace
+{
+
+// magic, formatVersion, reserved, payload size, payload CRC32
+constexpr size_t headerSize = 4 + 2 + 2 + 4 + 4;
+
+uint32_t crc32(std::span<const uint8_t> data)
+{
+    boost::crc_32_type crc;
+    crc.process_bytes(data.data(), data.size());
+    return crc.checksum();
+}
+
+// Little endian encoding, so that file does not depend on host byte order
+class Writer
+{
+  public:
+    explicit Writer(std::vector<uint8_t>& out_) : out(out_)
+    {
+    }
+
+    void put(uint8_t value)
+    {
+        out.push_back(value);
+    }
+    void put16(uint16_t value)
+    {
+        put(static_cast<uint8_t>(value));
+        put(static_cast<uint8_t>(value >> 8));
+    }
+    void put32(uint32_t value)
+    {
+        put16(static_cast<uint16_t>(value));
+        put16(static_cast<uint16_t>(value >> 16));
+    }
+    void putBytes(std::span<const uint8_t> bytes)
+    {
+        put16(static_cast<uint16_t>(bytes.size()));
+        out.insert(out.end(), bytes.begin(), bytes.end());
+    }
+
+  private:
+    std::vector<uint8_t>& out;
+};
+
+// Reads fail once data is exhausted, failed reader returns zeros
+class Reader
+{
+  public:
+    explicit Reader(std::span<const uint8_t> data_) : data(data_)
+    {
+    }
+
+    bool ok() const
+    {
+        return !failed;
+    }
+    bool atEnd() const
+    {
+        return data.empty();
+    }
+
+    uint8_t get()
+    {
+        if (data.empty())
+        {
+            failed = true;
+            return 0;
+        }
+        uint8_t value = data.front();
+        data = data.subspan(1);
+        return value;
+    }
+    uint16_t get16()
+    {
+        uint16_t low = get();
+        return static_cast<uint16_t>(low | (get() << 8));
+    }
+    uint32_t get32()
+    {
+        uint32_t low = get16();
+        return low | (static_cast<uint32_t>(get16()) << 16);
+    }
+    std::span<const uint8_t> getBytes()
+    {
+        size_t size = get16();
+        if (data.size() < size)
+        {
+            failed = true;
+            return {};
+        }
+        auto bytes = data.first(size);
+        data = data.subspan(size);
+        return bytes;
+    }
+
+  private:
+    std::span<const uint8_t> data;
+    bool failed = false;
+};
+
+std::span<const uint8_t> asBytes(const std::string& str)
+{
+    return {reinterpret_cast<const uint8_t*>(str.data()), str.size()};
+}
+
+} // namespace
+
+CapabilityCache::CapabilityCache(boost::asio::io_context& ioc,
+                                 size_t maxEntries_,
+                                 std::chrono::milliseconds flushDelay_) :
+    flushTimer(ioc),
+    maxEntries(maxEntries_), flushDelay(flushDelay_)
+{
+}
+
+CapabilityCache::~CapabilityCache()
+{
+    flush();
+}
+
+bool CapabilityCache::load(const std::filesystem::path& file)
+{
+    path = file;
+    entries.clear();
+    lastStored.clear();
+    dirty = false;
+    flushTimer.cancel();
+
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+    {
+        phosphor::logging::log<phosphor::logging::level::INFO>(
+            ("Capability cache " + path.string() + " not found").c_str());
+        return false;
+    }
+    std::vector<uint8_t> data{std::istreambuf_iterator<char>(in),
+                              std::istreambuf_iterator<char>()};
+
+    auto loaded = deserialize(data);
+    if (!loaded)
+    {
+        phosphor::logging::log<phosphor::logging::level::WARNING>(
+            ("Capability cache " + path.string() +
+             " is corrupted or of unsupported version, ignoring it")
+                .c_str());
+        return false;
+    }
+    entries = std::move(*loaded);
+    evict();
+    phosphor::logging::log<phosphor::logging::level::INFO>(
+        ("Capability cache loaded with " + std::to_string(entries.size()) +
+         " endpoints")
+            .c_str());
+    return true;
+}
+
+std::optional<CapabilityCache::Entry>
+    CapabilityCache::find(const std::string& uuid) const
+{
+    auto it = entries.find(uuid);
+    if (it == entries.end())
+    {
+        return std::nullopt;
+    }
+    return it->second;
+}
+
+void CapabilityCache::store(const std::string& uuid, const Entry& entry)
+{
+    if (!isEnabled())
+    {
+        return;
+    }
+    lastStored[uuid] = ++storeCount;
+    auto [it, inserted] = entries.try_emplace(uuid, entry);
+    if (!inserted)
+    {
+        if (it->second == entry)
+        {
+            return;
+        }
+        it->second = entry;
+    }
+    else
+    {
+        evict();
+    }
+
+    dirty = true;
+    flushTimer.expires_after(flushDelay);
+    flushTimer.async_wait([this](const boost::system::error_code& ec) {
+        if (!ec)
+        {
+            flush();
+        }
+    });
+}
+
+void CapabilityCache::flush()
+{
+    if (!dirty)
+    {
+        return;
+    }
+    dirty = false;
+    flushTimer.cancel();
+    save();
+}
+
+void CapabilityCache::evict()
+{
+    while (entries.size() > maxEntries)
+    {
+        // Loaded entries have no store yet, so they go before stored ones
+        auto oldest = std::min_element(
+            entries.begin(), entries.end(), [this](auto& a, auto& b) {
+                auto storeOf = [this](const std::string& uuid) {
+                    auto it = lastStored.find(uuid);
+                    return it == lastStored.end() ? 0 : it->second;
+                };
+                return storeOf(a.first) < storeOf(b.first);
+            });
+        lastStored.erase(oldest->first);
+        entries.erase(oldest);
+        dirty = true;
+    }
+}
+
+std::vector<uint8_t> CapabilityCache::serialize(
+    const std::unordered_map<std::string, Entry>& entries)
+{
+    std::vector<uint8_t> data(headerSize);
+    Writer payload(data);
+    payload.put32(static_cast<uint32_t>(entries.size()));
+    for (const auto& [uuid, entry] : entries)
+    {
+        payload.putBytes(asBytes(uuid));
+        payload.put16(static_cast<uint16_t>(entry.controlVersions.size()));
+        for (const auto& version : entry.controlVersions)
+        {
+            payload.put(version.major);
+            payload.put(version.minor);
+            payload.put(version.update);
+            payload.put(version.alpha);
+        }
+        payload.putBytes(entry.msgTypes);
+        payload.putBytes(asBytes(entry.vendorIdFormat));
+        payload.put16(
+            static_cast<uint16_t>(entry.vendorIdCapabilitySets.size()));
+        for (auto set : entry.vendorIdCapabilitySets)
+        {
+            payload.put16(set);
+        }
+    }
+
+    std::vector<uint8_t> header;
+    Writer headerWriter(header);
+    headerWriter.put32(magic);
+    headerWriter.put16(formatVersion);
+    headerWriter.put16(0);
+    headerWriter.put32(static_cast<uint32_t>(data.size() - headerSize));
+    headerWriter.put32(crc32(std::span(data).subspan(headerSize)));
+    std::copy(header.begin(), header.end(), data.begin());
+    return data;
+}
+
+std::optional<std::unordered_map<std::string, CapabilityCache::Entry>>
+    CapabilityCache::deserialize(std::span<const uint8_t> data)
+{
+    Reader header(data);
+    if (header.get32() != magic || header.get16() != formatVersion)
+    {
+        return std::nullopt;
+    }
+    header.get16();
+    uint32_t payloadSize = header.get32();
+    uint32_t payloadCrc = header.get32();
+    if (!header.ok() || data.size() - headerSize != payloadSize ||
+        crc32(data.subspan(headerSize)) != payloadCrc)
+    {
+        return std::nullopt;
+    }
+
+    std::unordered_map<std::string, Entry> entries;
+    Reader payload(data.subspan(headerSize));
+    uint32_t count = payload.get32();
+    for (uint32_t i = 0; i < count && payload.ok(); i++)
+    {
+        auto uuid = payload.getBytes();
+        Entry entry;
+        uint16_t versionCount = payload.get16();
+        for (uint16_t v = 0; v < versionCount && payload.ok(); v++)
+        {
+            MCTPVersionFields version;
+            version.major = payload.get();
+            version.minor = payload.get();
+            version.update = payload.get();
+            version.alpha = payload.get();
+            entry.controlVersions.push_back(version);
+        }
+        auto msgTypes = payload.getBytes();
+        entry.msgTypes.assign(msgTypes.begin(), msgTypes.end());
+        auto vendorIdFormat = payload.getBytes();
+        entry.vendorIdFormat.assign(vendorIdFormat.begin(),
+                                    vendorIdFormat.end());
+        uint16_t setCount = payload.get16();
+        for (uint16_t s = 0; s < setCount && payload.ok(); s++)
+        {
+            entry.vendorIdCapabilitySets.push_back(payload.get16());
+        }
+        entries.insert_or_assign(std::string(uuid.begin(), uuid.end()),
+                                 std::move(entry));
+    }
+    if (!payload.ok() || !payload.atEnd())
+    {
+        return std::nullopt;
+    }
+    return entries;
+}
+
+// File is replaced by rename, so that it is never left partially written
+void CapabilityCache::save() const
+{
+    std::error_code ec;
+    std::filesystem::create_directories(path.parent_path(), ec);
+
+    auto tmpPath = path;
+    tmpPath += ".tmp";
+    auto data = serialize(entries);
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(data.data()),
+                  static_cast<std::streamsize>(data.size()));
+        if (!out)
+        {
+            phosphor::logging::log<phosphor::logging::level::WARNING>(
+                ("Unable to write capability cache " + tmpPath.string())
+                    .c_str());
+            return;
+        }
+    }
+    std::filesystem::rename(tmpPath, path, ec);
+    if (ec)
+    {
+        phosphor::logging::log<phosphor::logging::level::WARNING>(
+            ("Unable to replace capability cache " + path.string() + ": " +
+             ec.message())
+                .c_str());
+    }
+}
+
+} // namespace mctpd
@@ -0,0 +1,120 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "utils/circuit_breaker.hpp"
+
+namespace mctpd
+{
+
+void CircuitBreaker::setPolicy(unsigned int threshold_,
+                               std::chrono::milliseconds probeInterval_)
+{
+    threshold = threshold_;
+    probeInterval = probeInterval_;
+}
+
+void CircuitBreaker::setStateObserver(StateObserver observer)
+{
+    stateObserver = std::move(observer);
+}
+
+bool CircuitBreaker::allowRequest(mctp_eid_t eid)
+{
+    auto it = endpoints.find(eid);
+    if (it == endpoints.end() || it->second.state == State::closed)
+    {
+        return true;
+    }
+
+    // Probe which got lost without response or timeout is replaced after
+    // another probe interval
+    auto& endpoint = it->second;
+    const auto now = std::chrono::steady_clock::now();
+    if (now < endpoint.nextProbeAt)
+    {
+        return false;
+    }
+    endpoint.nextProbeAt = now + probeInterval;
+    setState(eid, endpoint, State::halfOpen);
+    return true;
+}
+
+void CircuitBreaker::onSuccess(mctp_eid_t eid)
+{
+    auto it = endpoints.find(eid);
+    if (it == endpoints.end())
+    {
+        return;
+    }
+    it->second.timeouts = 0;
+    setState(eid, it->second, State::closed);
+}
+
+void CircuitBreaker::onTimeout(mctp_eid_t eid)
+{
+    if (threshold == 0)
+    {
+        return;
+    }
+
+    auto& endpoint = endpoints[eid];
+    ++endpoint.timeouts;
+    if (endpoint.state == State::halfOpen || endpoint.timeouts >= threshold)
+    {
+        endpoint.nextProbeAt = std::chrono::steady_clock::now() + probeInterval;
+        setState(eid, endpoint, State::open);
+    }
+}
+
+void CircuitBreaker::forget(mctp_eid_t eid)
+{
+    endpoints.erase(eid);
+}
+
+CircuitBreaker::State CircuitBreaker::getState(mctp_eid_t eid) const
+{
+    auto it = endpoints.find(eid);
+    return it == endpoints.end() ? State::closed : it->second.state;
+}
+
+std::string CircuitBreaker::toString(State state)
+{
+    switch (state)
+    {
+        case State::open:
+            return "Open";
+        case State::halfOpen:
+            return "HalfOpen";
+        default:
+            return "Closed";
+    }
+}
+
+void CircuitBreaker::setState(mctp_eid_t eid, Endpoint& endpoint,
+                              State state)
+{
+    if (endpoint.state == state)
+    {
+        return;
+    }
+    endpoint.state = state;
+    if (stateObserver)
+    {
+        stateObserver(eid, state);
+    }
+}
+
+} // namespace mctpd
@@ -0,0 +1,159 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "utils/ctrl_resp_view.hpp"
+
+#include <phosphor-logging/log.hpp>
+
+using mctpd::CtrlRespView;
+using mctpd::MsgTypeSupportView;
+using mctpd::VdmSupportView;
+using mctpd::VersionSupportView;
+
+// Control message header is followed by completion code in every response
+static constexpr size_t completionCodeOffset = sizeof(mctp_ctrl_msg_hdr);
+static constexpr size_t minRespSize = completionCodeOffset + 1;
+
+// Response header and count of list entries which follow it
+static constexpr size_t listOffset = minRespSize + 1;
+static constexpr size_t versionSize = sizeof(MCTPVersionFields);
+
+// Completion code, vendor ID set selector, vendor ID format, format data and
+// command set type
+static constexpr size_t vendorIdSetOffset = minRespSize;
+static constexpr size_t vendorIdFormatOffset = vendorIdSetOffset + 1;
+static constexpr size_t vendorIdFormatDataOffset = vendorIdFormatOffset + 1;
+static constexpr size_t commandSetTypeOffset = vendorIdFormatDataOffset + 2;
+static constexpr size_t vdmSupportRespSize = commandSetTypeOffset + 2;
+
+std::optional<CtrlRespView> CtrlRespView::decode(std::span<const uint8_t> resp,
+                                                 size_t minSize, size_t maxSize)
+{
+    if (resp.size() < minRespSize)
+    {
+        phosphor::logging::log<phosphor::logging::level::ERR>(
+            "Invalid response length",
+            phosphor::logging::entry("LEN=%d", resp.size()));
+        return std::nullopt;
+    }
+
+    const uint8_t completionCode = resp[completionCodeOffset];
+    if (completionCode != MCTP_CTRL_CC_SUCCESS || resp.size() < minSize ||
+        resp.size() > maxSize)
+    {
+        phosphor::logging::log<phosphor::logging::level::ERR>(
+            "Invalid response", phosphor::logging::entry("LEN=%d", resp.size()),
+            phosphor::logging::entry("CC=0x%02X", completionCode));
+        return std::nullopt;
+    }
+    return CtrlRespView(resp);
+}
+
+uint8_t CtrlRespView::completionCode() const
+{
+    return resp[completionCodeOffset];
+}
+
+uint16_t CtrlRespView::getBe16(size_t offset) const
+{
+    return static_cast<uint16_t>(resp[offset] << 8 | resp[offset + 1]);
+}
+
+/*
+ * Both lists have count byte after completion code and at least one entry,
+ * which fill rest of the response.
+ */
+static bool checkListLength(std::span<const uint8_t> resp, size_t entrySize)
+{
+    const size_t count = resp[listOffset - 1];
+    if (count == 0 || resp.size() - listOffset != count * entrySize)
+    {
+        phosphor::logging::log<phosphor::logging::level::ERR>(
+            "Invalid response length",
+            phosphor::logging::entry("LEN=%d", resp.size()),
+            phosphor::logging::entry("COUNT=%d", count));
+        return false;
+    }
+    return true;
+}
+
+std::optional<MsgTypeSupportView>
+    MsgTypeSupportView::decode(std::span<const uint8_t> resp)
+{
+    if (!CtrlRespView::decode(resp, listOffset) ||
+        !checkListLength(resp, sizeof(uint8_t)))
+    {
+        return std::nullopt;
+    }
+    return MsgTypeSupportView(resp);
+}
+
+std::span<const uint8_t> MsgTypeSupportView::msgTypes() const
+{
+    return resp.subspan(listOffset);
+}
+
+std::optional<VersionSupportView>
+    VersionSupportView::decode(std::span<const uint8_t> resp)
+{
+    if (!CtrlRespView::decode(resp, listOffset) ||
+        !checkListLength(resp, versionSize))
+    {
+        return std::nullopt;
+    }
+    return VersionSupportView(resp);
+}
+
+size_t VersionSupportView::count() const
+{
+    return (resp.size() - listOffset) / versionSize;
+}
+
+MCTPVersionFields VersionSupportView::version(size_t index) const
+{
+    auto entry = resp.subspan(listOffset + index * versionSize, versionSize);
+    return {entry[0], entry[1], entry[2], entry[3]};
+}
+
+std::optional<VdmSupportView>
+    VdmSupportView::decode(std::span<const uint8_t> resp)
+{
+    if (!CtrlRespView::decode(resp, vdmSupportRespSize))
+    {
+        return std::nullopt;
+    }
+    return VdmSupportView(resp);
+}
+
+uint8_t VdmSupportView::vendorIdSet() const
+{
+    return resp[vendorIdSetOffset];
+}
+
+uint8_t VdmSupportView::vendorIdFormat() const
+{
+    return resp[vendorIdFormatOffset];
+}
+
+uint16_t VdmSupportView::vendorIdFormatData() const
+{
+    return getBe16(vendorIdFormatDataOffset);
+}
+
+uint16_t VdmSupportView::commandSetType() const
+{
+    return getBe16(commandSetTypeOffset);
+}
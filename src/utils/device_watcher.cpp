@@ -39,13 +39,12 @@ void DeviceWatcher::deviceDiscoveryInit()
     }
 }
 
-bool DeviceWatcher::isDeviceGoodForInit(const BindingPrivateVect& bindingPvt)
+bool DeviceWatcher::isDeviceGoodForInit(const BindingPrivate& bindingPvt)
 {
     return ignoreList.count(bindingPvt) == 0;
 }
 
-bool DeviceWatcher::checkDeviceInitThreshold(
-    const BindingPrivateVect& bindingPvt)
+bool DeviceWatcher::checkDeviceInitThreshold(const BindingPrivate& bindingPvt)
 {
     constexpr int successiveDeviceInitThold = 10;
 
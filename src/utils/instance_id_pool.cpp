@@ -0,0 +1,63 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "utils/instance_id_pool.hpp"
+
+#include <bit>
+
+namespace mctpd
+{
+
+std::optional<uint8_t> InstanceIdPool::allocate(const mctp_eid_t eid)
+{
+    auto& destination = destinations[eid];
+    for (uint8_t i = 0; i < instanceIdCount; i++)
+    {
+        const uint8_t instanceId =
+            static_cast<uint8_t>((destination.next + i) % instanceIdCount);
+        const uint32_t bit = uint32_t{1} << instanceId;
+        if ((destination.used & bit) == 0)
+        {
+            destination.used |= bit;
+            destination.next =
+                static_cast<uint8_t>((instanceId + 1) % instanceIdCount);
+            return instanceId;
+        }
+    }
+    return std::nullopt;
+}
+
+void InstanceIdPool::release(const mctp_eid_t eid, const uint8_t instanceId)
+{
+    auto it = destinations.find(eid);
+    if (it == destinations.end())
+    {
+        return;
+    }
+    it->second.used &= ~(uint32_t{1} << (instanceId % instanceIdCount));
+}
+
+size_t InstanceIdPool::inUse(const mctp_eid_t eid) const
+{
+    auto it = destinations.find(eid);
+    if (it == destinations.end())
+    {
+        return 0;
+    }
+    return static_cast<size_t>(std::popcount(it->second.used));
+}
+
+} // namespace mctpd
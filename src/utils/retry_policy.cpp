@@ -0,0 +1,48 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "utils/retry_policy.hpp"
+
+#include <algorithm>
+
+namespace mctpd
+{
+
+std::chrono::milliseconds
+    RetryPolicy::getTimeout(unsigned int attempt,
+                            std::minstd_rand& random) const
+{
+    const std::chrono::milliseconds limit =
+        maxTimeout.count() > 0 ? maxTimeout : timeoutCeiling;
+    std::chrono::milliseconds result = timeout;
+    for (unsigned int i = 0; i < attempt && backoffFactor > 1 && result < limit;
+         i++)
+    {
+        result *= backoffFactor;
+    }
+    result = std::min(result, std::max(limit, timeout));
+
+    const auto jitter = result.count() * std::min(jitterPercent, 100u) / 100;
+    if (jitter > 0)
+    {
+        std::uniform_int_distribution<std::chrono::milliseconds::rep>
+            distribution(-jitter, jitter);
+        result += std::chrono::milliseconds(distribution(random));
+    }
+    return std::max(result, std::chrono::milliseconds{1});
+}
+
+} // namespace mctpd
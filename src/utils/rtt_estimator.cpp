@@ -0,0 +1,88 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "utils/rtt_estimator.hpp"
+
+#include <algorithm>
+
+namespace mctpd
+{
+
+// Timeout never gets closer to SRTT than clock granularity
+static constexpr std::chrono::microseconds granularity{1000};
+static constexpr unsigned int maxBackoff = 6;
+
+void RttEstimator::setTimeoutLimits(std::chrono::milliseconds minTimeout_,
+                                    std::chrono::milliseconds maxTimeout_)
+{
+    minTimeout = minTimeout_;
+    maxTimeout = std::max(maxTimeout_, minTimeout_);
+}
+
+void RttEstimator::addSample(mctp_eid_t eid, std::chrono::microseconds rtt)
+{
+    auto [it, inserted] = endpoints.try_emplace(eid);
+    auto& endpoint = it->second;
+    endpoint.backoff = 0;
+    if (inserted)
+    {
+        endpoint.smoothedRtt = rtt;
+        endpoint.rttVariance = rtt / 2;
+        return;
+    }
+
+    // RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|, SRTT = 7/8 SRTT + 1/8 R
+    const auto error = endpoint.smoothedRtt - rtt;
+    endpoint.rttVariance =
+        (endpoint.rttVariance * 3 + (error < error.zero() ? -error : error)) /
+        4;
+    endpoint.smoothedRtt = (endpoint.smoothedRtt * 7 + rtt) / 8;
+}
+
+void RttEstimator::addTimeout(mctp_eid_t eid)
+{
+    auto it = endpoints.find(eid);
+    if (it != endpoints.end())
+    {
+        it->second.backoff = std::min(it->second.backoff + 1, maxBackoff);
+    }
+}
+
+void RttEstimator::forget(mctp_eid_t eid)
+{
+    endpoints.erase(eid);
+}
+
+std::optional<RttEstimator::Estimate>
+    RttEstimator::getEstimate(mctp_eid_t eid) const
+{
+    auto it = endpoints.find(eid);
+    if (it == endpoints.end())
+    {
+        return std::nullopt;
+    }
+
+    const auto& endpoint = it->second;
+    const auto rto = endpoint.smoothedRtt +
+                     std::max(granularity, endpoint.rttVariance * 4);
+    const auto timeout =
+        std::clamp(std::chrono::ceil<std::chrono::milliseconds>(rto) *
+                       (1 << endpoint.backoff),
+                   minTimeout, maxTimeout);
+    return Estimate{endpoint.smoothedRtt, endpoint.rttVariance, timeout};
+}
+
+} // namespace mctpd
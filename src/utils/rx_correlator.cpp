@@ -0,0 +1,142 @@
+/*
+// Copyright (c) 2022 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "utils/rx_correlator.hpp"
+
+namespace mctpd
+{
+
+static bool acceptsAnySource(mctp_eid_t eid)
+{
+    return eid == MCTP_EID_NULL || eid == MCTP_EID_BROADCAST;
+}
+
+RxCorrelator::Key RxCorrelator::getKey(mctp_eid_t eid, uint8_t tag)
+{
+    return static_cast<Key>(eid << 3 | (tag & MCTP_HDR_TAG_MASK));
+}
+
+std::optional<uint8_t> RxCorrelator::allocateTag(mctp_eid_t eid)
+{
+    const uint8_t freeTags = static_cast<uint8_t>(~usedTags[eid]);
+    if (!freeTags)
+    {
+        return std::nullopt;
+    }
+    const auto tag = static_cast<uint8_t>(__builtin_ctz(freeTags));
+    usedTags[eid] |= static_cast<uint8_t>(1 << tag);
+    return tag;
+}
+
+void RxCorrelator::releaseTag(mctp_eid_t eid, uint8_t tag)
+{
+    const auto mask = static_cast<uint8_t>(1 << tag);
+    if ((usedTags[eid] & mask) == 0)
+    {
+        return;
+    }
+    usedTags[eid] &= static_cast<uint8_t>(~mask);
+    for (const auto& [id, observer] : releaseObservers)
+    {
+        observer(eid);
+    }
+}
+
+bool RxCorrelator::hasFreeTag(mctp_eid_t eid) const
+{
+    return usedTags[eid] != 0xff;
+}
+
+size_t RxCorrelator::addReleaseObserver(ReleaseObserver observer)
+{
+    releaseObservers.emplace(nextObserverId, std::move(observer));
+    return nextObserverId++;
+}
+
+void RxCorrelator::removeReleaseObserver(size_t id)
+{
+    releaseObservers.erase(id);
+}
+
+void RxCorrelator::expect(mctp_eid_t eid, uint8_t tag, Handler handler,
+                          bool oneShot)
+{
+    auto [it, inserted] = pending.insert_or_assign(
+        getKey(eid, tag), Pending{std::move(handler), oneShot});
+    if (inserted && acceptsAnySource(eid))
+    {
+        ++anySourceCount;
+    }
+}
+
+void RxCorrelator::forget(mctp_eid_t eid, uint8_t tag)
+{
+    if (pending.erase(getKey(eid, tag)) != 0 && acceptsAnySource(eid))
+    {
+        --anySourceCount;
+    }
+}
+
+bool RxCorrelator::dispatch(mctp_eid_t srcEid, uint8_t tag,
+                            std::span<const uint8_t> response)
+{
+    if (dispatch(getKey(srcEid, tag), response))
+    {
+        return true;
+    }
+    if (anySourceCount == 0 || acceptsAnySource(srcEid))
+    {
+        return false;
+    }
+    return dispatch(getKey(MCTP_EID_NULL, tag), response) ||
+           dispatch(getKey(MCTP_EID_BROADCAST, tag), response);
+}
+
+bool RxCorrelator::dispatch(Key key, std::span<const uint8_t> response)
+{
+    auto it = pending.find(key);
+    if (it == pending.end())
+    {
+        return false;
+    }
+
+    // Handler may register or forget requests, so it is taken out first
+    Pending request = std::move(it->second);
+    pending.erase(it);
+    const bool anySource = acceptsAnySource(static_cast<mctp_eid_t>(key >> 3));
+    if (anySource)
+    {
+        --anySourceCount;
+    }
+
+    if (request.handler(response))
+    {
+        return true;
+    }
+    if (!request.oneShot &&
+        pending.try_emplace(key, std::move(request)).second && anySource)
+    {
+        ++anySourceCount;
+    }
+    return false;
+}
+
+size_t RxCorrelator::pendingCount() const
+{
+    return pending.size();
+}
+
+} // namespace mctpd
@@ -0,0 +1,82 @@
+/*
+// Copyright (c) 2021 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "utils/slab_pool.hpp"
+
+#include <algorithm>
+#include <new>
+
+namespace mctpd
+{
+
+SlabPool::SlabPool(size_t blocksPerSlab_) : blocksPerSlab(blocksPerSlab_)
+{
+}
+
+void* SlabPool::allocate(size_t size, size_t alignment)
+{
+    if (blockSize == 0)
+    {
+        constexpr size_t align = alignof(std::max_align_t);
+        blockSize =
+            (std::max(size, sizeof(FreeBlock)) + align - 1) & ~(align - 1);
+    }
+
+    if (size > blockSize || alignment > alignof(std::max_align_t))
+    {
+        return ::operator new(size);
+    }
+
+    if (!freeList)
+    {
+        addSlab();
+    }
+    FreeBlock* block = freeList;
+    freeList = block->next;
+    return block;
+}
+
+void SlabPool::deallocate(void* ptr, size_t size, size_t alignment)
+{
+    if (size > blockSize || alignment > alignof(std::max_align_t))
+    {
+        ::operator delete(ptr);
+        return;
+    }
+
+    auto block = static_cast<FreeBlock*>(ptr);
+    block->next = freeList;
+    freeList = block;
+}
+
+size_t SlabPool::getSlabCount() const
+{
+    return slabs.size();
+}
+
+void SlabPool::addSlab()
+{
+    auto& slab = slabs.emplace_back(
+        std::make_unique<std::byte[]>(blockSize * blocksPerSlab));
+    for (size_t i = 0; i < blocksPerSlab; i++)
+    {
+        auto block = reinterpret_cast<FreeBlock*>(&slab[i * blockSize]);
+        block->next = freeList;
+        freeList = block;
+    }
+}
+
+} // namespace mctpd
@@ -0,0 +1,209 @@
+/*
+// Copyright (c) 2021 Intel Corporation
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//      http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+*/
+
+#include "utils/timing_wheel.hpp"
+
+#include <bit>
+
+namespace mctpd
+{
+
+static constexpr uint64_t slotMask = TimingWheel::slotCount - 1;
+
+TimingWheel::TimingWheel(boost::asio::io_context& ioc, ExpiryHandler handler,
+                         std::chrono::milliseconds resolution_) :
+    timer(ioc),
+    onExpiry(std::move(handler)), resolution(resolution_), start(Clock::now())
+{
+}
+
+uint64_t TimingWheel::toTick(Clock::time_point time) const
+{
+    return static_cast<uint64_t>((time - start) / resolution);
+}
+
+void TimingWheel::schedule(Entry& entry, Clock::duration timeout)
+{
+    cancel(entry);
+    advance();
+
+    const auto ticks = std::chrono::ceil<std::chrono::milliseconds>(timeout) /
+                       resolution;
+    entry.expiryTick = currentTick + static_cast<uint64_t>(std::max(
+                                         ticks, decltype(ticks){1}));
+    insert(entry);
+    arm();
+}
+
+void TimingWheel::cancel(Entry& entry)
+{
+    if (!entry.isScheduled())
+    {
+        return;
+    }
+
+    entry.unlink();
+    auto& level = levels[entry.level];
+    if (level.slots[entry.slot].empty())
+    {
+        level.occupied &= ~(uint64_t{1} << entry.slot);
+    }
+    arm();
+}
+
+/*
+ * Entry goes to the lowest level whose span covers the remaining time. Slots
+ * are indexed by expiry bits of that level, so entry is met again exactly
+ * when its slot is processed (level 0) or cascaded down (higher levels).
+ */
+void TimingWheel::insert(Entry& entry)
+{
+    uint64_t delta = entry.expiryTick - currentTick;
+    uint64_t tick = entry.expiryTick;
+    if (delta >= range)
+    {
+        delta = range - 1;
+        tick = currentTick + delta;
+    }
+
+    size_t level = 0;
+    while (delta >= (uint64_t{1} << (slotBits * (level + 1))))
+    {
+        level++;
+    }
+
+    const auto slot =
+        static_cast<uint8_t>((tick >> (slotBits * level)) & slotMask);
+    entry.level = static_cast<uint8_t>(level);
+    entry.slot = slot;
+    levels[level].slots[slot].push_back(entry);
+    levels[level].occupied |= uint64_t{1} << slot;
+}
+
+void TimingWheel::cascade(size_t level, uint8_t slot, uint64_t tick,
+                          Slot& expired)
+{
+    Slot entries;
+    entries.swap(levels[level].slots[slot]);
+    levels[level].occupied &= ~(uint64_t{1} << slot);
+
+    while (!entries.empty())
+    {
+        Entry& entry = entries.front();
+        entries.pop_front();
+        if (entry.expiryTick <= tick)
+        {
+            expired.push_back(entry);
+        }
+        else
+        {
+            insert(entry);
+        }
+    }
+}
+
+void TimingWheel::processTick(uint64_t tick, Slot& expired)
+{
+    for (size_t level = levelCount - 1; level > 0; level--)
+    {
+        const size_t shift = slotBits * level;
+        if ((tick & ((uint64_t{1} << shift) - 1)) == 0)
+        {
+            cascade(level, static_cast<uint8_t>((tick >> shift) & slotMask),
+                    tick, expired);
+        }
+    }
+    cascade(0, static_cast<uint8_t>(tick & slotMask), tick, expired);
+}
+
+std::optional<uint64_t> TimingWheel::nextEventTick() const
+{
+    std::optional<uint64_t> next;
+    for (size_t level = 0; level < levelCount; level++)
+    {
+        const uint64_t occupied = levels[level].occupied;
+        if (!occupied)
+        {
+            continue;
+        }
+
+        // Distance from current position to the nearest occupied slot
+        const size_t shift = slotBits * level;
+        const uint64_t position = currentTick >> shift;
+        const auto rotation =
+            static_cast<int>(((position & slotMask) + 1) % slotCount);
+        const int emptySlots = std::countr_zero(std::rotr(occupied, rotation));
+        const auto distance = static_cast<uint64_t>(emptySlots) + 1;
+        const uint64_t tick = (position + distance) << shift;
+        if (!next || tick < *next)
+        {
+            next = tick;
+        }
+    }
+    return next;
+}
+
+void TimingWheel::advance()
+{
+    const uint64_t nowTick = toTick(Clock::now());
+    Slot expired;
+    for (auto next = nextEventTick(); next && *next <= nowTick;
+         next = nextEventTick())
+    {
+        currentTick = *next;
+        processTick(currentTick, expired);
+    }
+    currentTick = std::max(currentTick, nowTick);
+
+    while (!expired.empty())
+    {
+        Entry& entry = expired.front();
+        expired.pop_front();
+        onExpiry(entry);
+    }
+}
+
+void TimingWheel::arm()
+{
+    const auto next = nextEventTick();
+    if (!next)
+    {
+        if (timerTick)
+        {
+            timerTick.reset();
+            timer.cancel();
+        }
+        return;
+    }
+    if (timerTick == next)
+    {
+        return;
+    }
+
+    timerTick = next;
+    timer.expires_at(start + resolution * static_cast<Clock::rep>(*next));
+    timer.async_wait([this](const boost::system::error_code& ec) {
+        if (ec == boost::asio::error::operation_aborted)
+        {
+            return;
+        }
+        timerTick.reset();
+        advance();
+        arm();
+    });
+}
+
+} // namespace mctpd
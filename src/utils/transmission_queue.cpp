@@ -1,132 +1,706 @@
 #include "utils/transmission_queue.hpp"
 
+#include <algorithm>
+#include <cerrno>
 #include <phosphor-logging/log.hpp>
 
 using mctpd::MctpTransmissionQueue;
 
+// Errors which will not go away by retransmitting the same message
+static bool isPermanentTxError(int rc)
+{
+    switch (-rc)
+    {
+        case EINVAL:
+        case EMSGSIZE:
+        case ENODEV:
+        case ENXIO:
+        case EHOSTUNREACH:
+        case EOPNOTSUPP:
+            return true;
+        default:
+            return false;
+    }
+}
+
+// PLDM header follows MCTP message type byte
+static constexpr size_t pldmHeaderSize = 4;
+static constexpr uint8_t pldmRequestBit = 0x80;
+static constexpr uint8_t pldmInstanceIdMask = 0x1f;
+static constexpr uint8_t pldmTypeMask = 0x3f;
+
+MctpTransmissionQueue::MctpTransmissionQueue(
+    boost::asio::io_context& ioc, std::shared_ptr<RxCorrelator> correlator_) :
+    io(ioc),
+    correlator(std::move(correlator_)),
+    messagePool(std::make_shared<SlabPool>()),
+    timingWheel(ioc,
+                [this](TimingWheel::Entry& entry) {
+                    complete(static_cast<Message&>(entry),
+                             boost::asio::error::timed_out);
+                }),
+    wakeupTimer(ioc)
+{
+    releaseObserverId = correlator->addReleaseObserver(
+        [this](mctp_eid_t destEid) { onTagReleased(destEid); });
+}
+
+MctpTransmissionQueue::~MctpTransmissionQueue()
+{
+    correlator->removeReleaseObserver(releaseObserverId);
+}
+
 MctpTransmissionQueue::Message::Message(size_t index_,
                                         std::vector<uint8_t>&& payload_,
-                                        std::vector<uint8_t>&& privateData_,
-                                        boost::asio::io_context& ioc) :
+                                        const BindingPrivate& privateData_) :
     index(index_),
-    payload(std::move(payload_)), privateData(std::move(privateData_)),
-    timer(ioc)
+    payload(std::move(payload_)), privateData(privateData_)
+{
+}
+
+void MctpTransmissionQueue::setWeight(mctp_eid_t destEid, unsigned weight)
+{
+    endpoints[destEid].weight = std::max(weight, 1u);
+}
+
+void MctpTransmissionQueue::setMaxInFlight(size_t limit)
+{
+    maxInFlight = limit;
+}
+
+void MctpTransmissionQueue::setPriorityClasses(
+    const std::vector<uint8_t>& msgTypes)
+{
+    priorityClasses.clear();
+    for (const uint8_t msgType : msgTypes)
+    {
+        priorityClasses.emplace(msgType,
+                                static_cast<uint8_t>(priorityClasses.size()));
+    }
+}
+
+void MctpTransmissionQueue::setStarvationTimeout(
+    std::chrono::milliseconds timeout)
+{
+    starvationTimeout = timeout;
+}
+
+uint8_t MctpTransmissionQueue::getPriorityClass(
+    const std::vector<uint8_t>& payload) const
+{
+    if (!payload.empty())
+    {
+        // Message type is always the first byte
+        auto it = priorityClasses.find(payload[0]);
+        if (it != priorityClasses.end())
+        {
+            return it->second;
+        }
+    }
+    return static_cast<uint8_t>(priorityClasses.size());
+}
+
+void MctpTransmissionQueue::setQueueLimits(size_t perEndpoint, size_t total)
+{
+    maxQueuedPerEndpoint = perEndpoint;
+    maxQueued = total;
+}
+
+void MctpTransmissionQueue::setRetryPolicy(unsigned count,
+                                           std::chrono::milliseconds delay)
+{
+    retryCount = count;
+    retryDelay = delay;
+}
+
+void MctpTransmissionQueue::setTagQuarantine(
+    std::chrono::milliseconds quarantine)
+{
+    tagQuarantine = quarantine;
+}
+
+void MctpTransmissionQueue::setCorrelationHook(uint8_t msgType,
+                                               CorrelationHook hook)
+{
+    correlationHooks.insert_or_assign(msgType, std::move(hook));
+}
+
+bool MctpTransmissionQueue::matchPldmInstanceId(
+    std::span<const uint8_t> request, std::span<const uint8_t> response)
+{
+    if (request.size() < pldmHeaderSize || response.size() < pldmHeaderSize)
+    {
+        return false;
+    }
+    return (response[1] & pldmRequestBit) == 0 &&
+           (request[1] & pldmInstanceIdMask) ==
+               (response[1] & pldmInstanceIdMask) &&
+           (request[2] & pldmTypeMask) == (response[2] & pldmTypeMask) &&
+           request[3] == response[3];
+}
+
+void MctpTransmissionQueue::setAdaptiveWindow(bool enabled, uint8_t initial)
 {
+    adaptiveWindow = enabled;
+    initialWindow = std::clamp(initial, uint8_t{1}, maxWindow);
 }
 
-std::optional<uint8_t> MctpTransmissionQueue::Tags::next() const
+void MctpTransmissionQueue::setWindowObserver(WindowObserver observer)
 {
-    if (!bits)
+    windowObserver = std::move(observer);
+}
+
+void MctpTransmissionQueue::setRttObserver(RttObserver observer)
+{
+    rttObserver = std::move(observer);
+}
+
+uint8_t MctpTransmissionQueue::getWindow(mctp_eid_t destEid) const
+{
+    auto it = endpoints.find(destEid);
+    if (it == endpoints.end())
     {
-        return std::nullopt;
+        return adaptiveWindow ? initialWindow : maxWindow;
     }
-    return static_cast<uint8_t>(__builtin_ctz(bits));
+    return windowOf(it->second);
 }
 
-void MctpTransmissionQueue::Tags::emplace(uint8_t flag)
+uint8_t MctpTransmissionQueue::windowOf(const Endpoint& endpoint) const
 {
-    bits |= static_cast<uint8_t>(1 << flag);
+    if (!adaptiveWindow)
+    {
+        return maxWindow;
+    }
+    return endpoint.window.value_or(initialWindow);
 }
 
-void MctpTransmissionQueue::Tags::erase(uint8_t flag)
+/*
+ * Additive increase, multiplicative decrease. Window grows by one message
+ * once whole window got answered in time and halves on every timeout.
+ */
+void MctpTransmissionQueue::updateWindow(mctp_eid_t destEid,
+                                         Endpoint& endpoint, bool timedOut)
 {
-    bits &= static_cast<uint8_t>(~(1 << flag));
+    if (!adaptiveWindow)
+    {
+        return;
+    }
+
+    const uint8_t window = windowOf(endpoint);
+    uint8_t updated = window;
+    if (timedOut)
+    {
+        updated = std::max(static_cast<uint8_t>(window / 2), uint8_t{1});
+        endpoint.windowResponses = 0;
+    }
+    else if (++endpoint.windowResponses >= window)
+    {
+        updated = std::min(static_cast<uint8_t>(window + 1), maxWindow);
+        endpoint.windowResponses = 0;
+    }
+    endpoint.window = updated;
+
+    if (updated != window && windowObserver)
+    {
+        windowObserver(destEid, updated);
+    }
+}
+
+std::map<mctp_eid_t, MctpTransmissionQueue::Statistics>
+    MctpTransmissionQueue::getStatistics() const
+{
+    std::map<mctp_eid_t, Statistics> statistics;
+    for (const auto& [eid, endpoint] : endpoints)
+    {
+        auto& stats =
+            statistics.emplace(eid, endpoint.statistics).first->second;
+        stats.queuedMessages = endpoint.queuedCount;
+    }
+    return statistics;
 }
 
 std::shared_ptr<MctpTransmissionQueue::Message> MctpTransmissionQueue::transmit(
     struct mctp* mctp, mctp_eid_t destEid, std::vector<uint8_t>&& payload,
-    std::vector<uint8_t>&& privateData, boost::asio::io_context& ioc)
+    const BindingPrivate& privateData,
+    std::chrono::steady_clock::time_point deadline)
 {
     auto& endpoint = endpoints[destEid];
+    if ((maxQueuedPerEndpoint != 0 &&
+         endpoint.queuedCount >= maxQueuedPerEndpoint) ||
+        (maxQueued != 0 && queuedCount >= maxQueued))
+    {
+        ++endpoint.statistics.rejectedMessages;
+        return nullptr;
+    }
+
     auto msgIndex = endpoint.msgCounter++;
-    auto message = std::make_shared<Message>(msgIndex, std::move(payload),
-                                             std::move(privateData), ioc);
-    endpoint.queuedMessages.emplace(msgIndex, message);
-    endpoint.transmitQueuedMessages(mctp, destEid);
+    auto message = std::allocate_shared<Message>(
+        PoolAllocator<Message>(messagePool), msgIndex, std::move(payload),
+        privateData);
+    message->priorityClass = getPriorityClass(message->payload);
+    message->queuedAt = std::chrono::steady_clock::now();
+    message->deadline = deadline;
+    enqueue(endpoint, message);
+    activate(destEid, endpoint);
+    transmitQueuedMessages(mctp);
     return message;
 }
 
-void MctpTransmissionQueue::Endpoint::transmitQueuedMessages(struct mctp* mctp,
-                                                             mctp_eid_t destEid)
+void MctpTransmissionQueue::activate(mctp_eid_t destEid, Endpoint& endpoint)
+{
+    if (!endpoint.active)
+    {
+        endpoint.active = true;
+        activeEndpoints.push_back(destEid);
+    }
+}
+
+void MctpTransmissionQueue::enqueue(Endpoint& endpoint,
+                                    std::shared_ptr<Message> message)
+{
+    MessageKey key{message->deadline, message->index};
+    endpoint.queuedMessages[message->priorityClass].emplace(key,
+                                                           std::move(message));
+    ++endpoint.queuedCount;
+    ++queuedCount;
+}
+
+bool MctpTransmissionQueue::isBlocked(struct mctp* mctp, mctp_eid_t destEid,
+                                      Endpoint& endpoint)
+{
+    const auto now = std::chrono::steady_clock::now();
+    if (endpoint.retryAt > now)
+    {
+        scheduleWakeup(mctp, endpoint.retryAt);
+        return true;
+    }
+
+    const auto quarantineEnd = releaseQuarantinedTags(destEid, endpoint, now);
+    // Response or timeout of in-flight message reopens the window
+    if (endpoint.transmittedCount >= windowOf(endpoint))
+    {
+        return true;
+    }
+    if (correlator->hasFreeTag(destEid))
+    {
+        return false;
+    }
+    if (quarantineEnd)
+    {
+        scheduleWakeup(mctp, *quarantineEnd);
+    }
+    // Tags may be held by control requests, which do not go through the queue
+    endpoint.awaitingTag = mctp;
+    return true;
+}
+
+void MctpTransmissionQueue::onTagReleased(mctp_eid_t destEid)
+{
+    auto it = endpoints.find(destEid);
+    if (it == endpoints.end() || !it->second.awaitingTag)
+    {
+        return;
+    }
+    // Tag is released from within its request's completion, resume after it
+    io.post([this, mctp = std::exchange(it->second.awaitingTag, nullptr)] {
+        transmitQueuedMessages(mctp);
+    });
+}
+
+std::optional<std::chrono::steady_clock::time_point>
+    MctpTransmissionQueue::releaseQuarantinedTags(
+        mctp_eid_t destEid, Endpoint& endpoint,
+        std::chrono::steady_clock::time_point now)
 {
-    while (!queuedMessages.empty())
+    std::optional<std::chrono::steady_clock::time_point> earliest;
+    auto it = endpoint.quarantinedTags.begin();
+    while (it != endpoint.quarantinedTags.end())
     {
-        const std::optional<uint8_t> nextTag = availableTags.next();
-        if (!nextTag)
+        if (it->second <= now)
         {
-            break;
+            correlator->forget(destEid, it->first);
+            correlator->releaseTag(destEid, it->first);
+            it = endpoint.quarantinedTags.erase(it);
+            continue;
+        }
+        if (!earliest || it->second < *earliest)
+        {
+            earliest = it->second;
+        }
+        ++it;
+    }
+    return earliest;
+}
+
+void MctpTransmissionQueue::scheduleWakeup(
+    struct mctp* mctp, std::chrono::steady_clock::time_point when)
+{
+    if (wakeupTimerExpiry && *wakeupTimerExpiry <= when)
+    {
+        return;
+    }
+    wakeupTimerExpiry = when;
+    wakeupTimer.expires_at(when);
+    wakeupTimer.async_wait([this, mctp](const boost::system::error_code& ec) {
+        if (ec == boost::asio::error::operation_aborted)
+        {
+            return;
+        }
+        wakeupTimerExpiry.reset();
+        releaseExpiredQuarantines(mctp);
+        transmitQueuedMessages(mctp);
+    });
+}
+
+// Quarantine ends on time whether or not messages are queued for endpoint
+void MctpTransmissionQueue::releaseExpiredQuarantines(struct mctp* mctp)
+{
+    const auto now = std::chrono::steady_clock::now();
+    std::optional<std::chrono::steady_clock::time_point> earliest;
+    for (auto& [destEid, endpoint] : endpoints)
+    {
+        const auto quarantineEnd =
+            releaseQuarantinedTags(destEid, endpoint, now);
+        if (quarantineEnd && (!earliest || *quarantineEnd < *earliest))
+        {
+            earliest = quarantineEnd;
+        }
+    }
+    if (earliest)
+    {
+        scheduleWakeup(mctp, *earliest);
+    }
+}
+
+/*
+ * Highest priority class is served first, unless head of some queue waits
+ * longer than starvation timeout. Then the oldest of such heads goes first.
+ */
+MctpTransmissionQueue::MessageQueue&
+    MctpTransmissionQueue::selectQueue(Endpoint& endpoint) const
+{
+    const auto now = std::chrono::steady_clock::now();
+    MessageQueue* starved = nullptr;
+    for (auto& [priorityClass, queue] : endpoint.queuedMessages)
+    {
+        const auto& head = queue.begin()->second;
+        if (now - head->queuedAt >= starvationTimeout &&
+            (!starved || head->index < starved->begin()->second->index))
+        {
+            starved = &queue;
         }
-        auto msgTag = nextTag.value();
-        auto queuedMessageIter = queuedMessages.begin();
-        auto message = std::move(queuedMessageIter->second);
-        queuedMessages.erase(queuedMessageIter);
+    }
+    return starved ? *starved : endpoint.queuedMessages.begin()->second;
+}
 
-        int rc = mctp_message_tx(mctp, destEid, message->payload.data(),
-                                 message->payload.size(), true, msgTag,
-                                 message->privateData.data());
-        if (rc < 0)
+/*
+ * Queues are ordered by deadline, so expired messages are always at their
+ * heads. Sending them would only waste bus time, requester already gave up.
+ */
+void MctpTransmissionQueue::shedExpiredMessages(
+    Endpoint& endpoint, std::chrono::steady_clock::time_point now)
+{
+    auto queueIter = endpoint.queuedMessages.begin();
+    while (queueIter != endpoint.queuedMessages.end())
+    {
+        auto& queue = queueIter->second;
+        while (!queue.empty() && queue.begin()->first.first <= now)
+        {
+            auto message = std::move(queue.begin()->second);
+            queue.erase(queue.begin());
+            --endpoint.queuedCount;
+            --queuedCount;
+            ++endpoint.statistics.shedMessages;
+            message->shed = true;
+            complete(*message, boost::asio::error::timed_out);
+        }
+        if (queue.empty())
         {
-            phosphor::logging::log<phosphor::logging::level::ERR>(
-                "Error in mctp_message_tx");
+            queueIter = endpoint.queuedMessages.erase(queueIter);
             continue;
         }
+        ++queueIter;
+    }
+}
 
-        availableTags.erase(msgTag);
-        message->tag = msgTag;
-        transmittedMessages.emplace(msgTag, std::move(message));
+bool MctpTransmissionQueue::inFlightLimitReached() const
+{
+    return maxInFlight != 0 && inFlight >= maxInFlight;
+}
+
+/*
+ * Deficit round robin across endpoints with queued messages. Each visit
+ * grants an endpoint quantum * weight bytes of credit, which is spent on
+ * queued payloads. Endpoints without a free tag are skipped without gaining
+ * credit, and the loop ends when a whole round made no progress.
+ */
+void MctpTransmissionQueue::transmitQueuedMessages(struct mctp* mctp)
+{
+    size_t blockedEndpoints = 0;
+    while (!activeEndpoints.empty() &&
+           blockedEndpoints < activeEndpoints.size() && !inFlightLimitReached())
+    {
+        const mctp_eid_t destEid = activeEndpoints.front();
+        activeEndpoints.pop_front();
+        auto& endpoint = endpoints[destEid];
+        shedExpiredMessages(endpoint, std::chrono::steady_clock::now());
+
+        if (endpoint.queuedMessages.empty())
+        {
+            endpoint.active = false;
+            endpoint.inService = false;
+            endpoint.deficit = 0;
+            continue;
+        }
+
+        if (isBlocked(mctp, destEid, endpoint))
+        {
+            activeEndpoints.push_back(destEid);
+            ++blockedEndpoints;
+            continue;
+        }
+        blockedEndpoints = 0;
+
+        if (!endpoint.inService)
+        {
+            endpoint.deficit += quantum * endpoint.weight;
+            endpoint.inService = true;
+        }
+
+        while (!endpoint.queuedMessages.empty() &&
+               !isBlocked(mctp, destEid, endpoint) && !inFlightLimitReached())
+        {
+            // Transmission may block, deadlines could pass meanwhile
+            shedExpiredMessages(endpoint, std::chrono::steady_clock::now());
+            if (endpoint.queuedMessages.empty())
+            {
+                break;
+            }
+            auto& queue = selectQueue(endpoint);
+            const size_t cost = queue.begin()->second->payload.size();
+            if (cost > endpoint.deficit)
+            {
+                break;
+            }
+            endpoint.deficit -= cost;
+            transmitMessage(mctp, destEid, endpoint, queue);
+        }
+
+        if (endpoint.queuedMessages.empty())
+        {
+            endpoint.active = false;
+            endpoint.inService = false;
+            endpoint.deficit = 0;
+            continue;
+        }
+
+        if (inFlightLimitReached())
+        {
+            // Endpoint continues its round once in-flight slot is released
+            activeEndpoints.push_front(destEid);
+            break;
+        }
+
+        endpoint.inService = false;
+        activeEndpoints.push_back(destEid);
     }
 }
 
-bool MctpTransmissionQueue::receive(struct mctp* mctp, mctp_eid_t srcEid,
-                                    uint8_t msgTag,
-                                    std::vector<uint8_t>&& response,
-                                    boost::asio::io_context& ioc)
+bool MctpTransmissionQueue::transmitMessage(struct mctp* mctp,
+                                            mctp_eid_t destEid,
+                                            Endpoint& endpoint,
+                                            MessageQueue& queue)
 {
-    auto endpointIter = endpoints.find(srcEid);
-    if (endpointIter == endpoints.end())
+    auto msgTag = correlator->allocateTag(destEid).value();
+    auto queuedMessageIter = queue.begin();
+    auto message = std::move(queuedMessageIter->second);
+    queue.erase(queuedMessageIter);
+    if (queue.empty())
     {
-        return false;
+        endpoint.queuedMessages.erase(message->priorityClass);
     }
+    --endpoint.queuedCount;
+    --queuedCount;
 
-    auto& endpoint = endpointIter->second;
-    auto messageIter = endpoint.transmittedMessages.find(msgTag);
-    if (messageIter == endpoint.transmittedMessages.end())
+    int rc = mctp_message_tx(mctp, destEid, message->payload.data(),
+                             message->payload.size(), true, msgTag,
+                             message->privateData.data());
+    if (rc < 0)
     {
+        correlator->releaseTag(destEid, msgTag);
+        if (!isPermanentTxError(rc) && message->txAttempts < retryCount)
+        {
+            // Back off whole endpoint, transient errors usually come from
+            // busy medium rather than from particular message
+            const unsigned int shift = std::min(message->txAttempts, 16u);
+            const auto delay =
+                std::min(retryDelay * (1u << shift), maxRetryDelay);
+            ++message->txAttempts;
+            endpoint.retryAt = std::chrono::steady_clock::now() + delay;
+            phosphor::logging::log<phosphor::logging::level::WARNING>(
+                "mctp_message_tx failed, retrying",
+                phosphor::logging::entry("EID=%d", destEid),
+                phosphor::logging::entry("RC=%d", rc));
+            enqueue(endpoint, std::move(message));
+            scheduleWakeup(mctp, endpoint.retryAt);
+            return false;
+        }
+
+        phosphor::logging::log<phosphor::logging::level::ERR>(
+            "Error in mctp_message_tx",
+            phosphor::logging::entry("EID=%d", destEid),
+            phosphor::logging::entry("RC=%d", rc));
+        ++endpoint.statistics.failedMessages;
+        message->txFailed = true;
+        complete(*message, {});
         return false;
     }
 
-    const auto message = messageIter->second;
-    message->response = std::move(response);
-    endpoint.transmittedMessages.erase(messageIter);
+    ++inFlight;
+    ++endpoint.transmittedCount;
+    ++endpoint.statistics.transmittedMessages;
+    endpoint.statistics.transmittedBytes += message->payload.size();
+    message->tag = msgTag;
+    message->transmittedAt = std::chrono::steady_clock::now();
+    message->mctp = mctp;
+    message->destEid = destEid;
+    correlator->expect(destEid, msgTag,
+                       [this, message = std::move(message)](
+                           std::span<const uint8_t> response) {
+                           return onResponse(message, response);
+                       });
+    return true;
+}
+
+void MctpTransmissionQueue::releaseTag(mctp_eid_t destEid, Endpoint& endpoint,
+                                       uint8_t msgTag, bool quarantine)
+{
+    if (quarantine && tagQuarantine.count() > 0)
+    {
+        endpoint.quarantinedTags.insert_or_assign(
+            msgTag, std::chrono::steady_clock::now() + tagQuarantine);
+        // Late response to timed out message, its tag is safe to reuse now.
+        // Nobody waits for it anymore, so it is consumed here.
+        correlator->expect(
+            destEid, msgTag,
+            [this, destEid, msgTag](std::span<const uint8_t>) {
+                endpoints[destEid].quarantinedTags.erase(msgTag);
+                correlator->releaseTag(destEid, msgTag);
+                return true;
+            },
+            true);
+    }
+    else
+    {
+        correlator->releaseTag(destEid, msgTag);
+    }
+    if (endpoint.transmittedCount > 0)
+    {
+        --endpoint.transmittedCount;
+    }
+    if (inFlight > 0)
+    {
+        --inFlight;
+    }
+}
+
+bool MctpTransmissionQueue::receive(mctp_eid_t srcEid, uint8_t msgTag,
+                                    std::span<const uint8_t> response)
+{
+    return correlator->dispatch(srcEid, msgTag, response);
+}
+
+bool MctpTransmissionQueue::onResponse(const std::shared_ptr<Message>& message,
+                                       std::span<const uint8_t> response)
+{
+    const auto& request = message->payload;
+    const uint8_t msgTag = message->tag.value();
+    if (!request.empty())
+    {
+        auto hookIter = correlationHooks.find(request[0]);
+        if (hookIter != correlationHooks.end() &&
+            !hookIter->second(request, response))
+        {
+            phosphor::logging::log<phosphor::logging::level::WARNING>(
+                "Response does not match request, ignoring",
+                phosphor::logging::entry("EID=%d", message->destEid),
+                phosphor::logging::entry("TAG=%d", msgTag));
+            return false;
+        }
+    }
+
+    message->response.emplace(response.begin(), response.end());
     message->tag.reset();
-    endpoint.availableTags.emplace(msgTag);
+    if (rttObserver)
+    {
+        rttObserver(message->destEid,
+                    std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now() -
+                        message->transmittedAt));
+    }
+    auto& endpoint = endpoints[message->destEid];
+    releaseTag(message->destEid, endpoint, msgTag);
+    updateWindow(message->destEid, endpoint, false);
 
     // Now that another tag is available, try to transmit any queued messages
-    message->timer.cancel();
-    ioc.post([this, mctp, srcEid] {
-        endpoints[srcEid].transmitQueuedMessages(mctp, srcEid);
-    });
+    complete(*message, {});
+    io.post([this, mctp = message->mctp] { transmitQueuedMessages(mctp); });
     return true;
 }
 
-void MctpTransmissionQueue::dispose(mctp_eid_t destEid,
-                                    const std::shared_ptr<Message>& message)
+void MctpTransmissionQueue::complete(Message& message,
+                                     boost::system::error_code ec)
 {
+    timingWheel.cancel(message);
+    if (!message.waiter)
+    {
+        return;
+    }
+    boost::asio::post(io, [waiter = std::move(message.waiter), ec]() mutable {
+        waiter(ec);
+    });
+    message.waiter = nullptr;
+}
+
+void MctpTransmissionQueue::dispose(struct mctp* mctp, mctp_eid_t destEid,
+                                    const std::shared_ptr<Message>& message,
+                                    bool timedOut)
+{
+    timingWheel.cancel(*message);
     auto& endpoint = endpoints[destEid];
-    auto queuedMessageIter = endpoint.queuedMessages.find(message->index);
-    if (queuedMessageIter != endpoint.queuedMessages.end())
+    auto queueIter = endpoint.queuedMessages.find(message->priorityClass);
+    if (queueIter != endpoint.queuedMessages.end())
     {
-        endpoint.queuedMessages.erase(queuedMessageIter);
+        // Still queued means it was never sent, waiter gave up before
+        // its turn came
+        if (queueIter->second.erase({message->deadline, message->index}) != 0)
+        {
+            --endpoint.queuedCount;
+            --queuedCount;
+            ++endpoint.statistics.shedMessages;
+            message->shed = true;
+        }
+        if (queueIter->second.empty())
+        {
+            endpoint.queuedMessages.erase(queueIter);
+        }
     }
     if (message->tag)
     {
+        // Tag is set only while message waits for response
         auto msgTag = message->tag.value();
-        endpoint.availableTags.emplace(msgTag);
-
-        auto transmittedMessageIter = endpoint.transmittedMessages.find(msgTag);
-        if (transmittedMessageIter != endpoint.transmittedMessages.end())
+        message->tag.reset();
+        correlator->forget(destEid, msgTag);
+        releaseTag(destEid, endpoint, msgTag, true);
+        auto quarantined = endpoint.quarantinedTags.find(msgTag);
+        if (quarantined != endpoint.quarantinedTags.end())
+        {
+            scheduleWakeup(mctp, quarantined->second);
+        }
+        if (timedOut)
         {
-            endpoint.transmittedMessages.erase(transmittedMessageIter);
+            updateWindow(destEid, endpoint, true);
         }
+        transmitQueuedMessages(mctp);
     }
 }
\ No newline at end of file
@@ -23,6 +23,15 @@ class TestBinding : public MctpBinding
 
     virtual ~TestBinding() = default;
 
+    // Number of times ctrlTxTimer fired, i.e. retransmission wakeups
+    size_t ctrlTxTimerWakeups = 0;
+
+    void processCtrlTxQueue() override
+    {
+        ++ctrlTxTimerWakeups;
+        MctpBinding::processCtrlTxQueue();
+    }
+
     void initializeBinding() override
     {
         initializeMctp();
@@ -43,5 +52,9 @@ class TestBinding : public MctpBinding
     BindingBackdoor<PrvData> backdoor;
 
     /** Extract protected functions externally */
+    using MctpBinding::asyncSendAndRcvMctpCtrl;
+    using MctpBinding::correlator;
     using MctpBinding::getEidCtrlCmd;
+    using MctpBinding::sendReceiveMctpMessagePayload;
+    using MctpBinding::transmissionQueue;
 };
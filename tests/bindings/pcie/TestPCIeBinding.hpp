@@ -44,6 +44,10 @@ class TestPCIeBinding : public PCIeBinding
     Backdoor backdoor;
 
     // Extract protected members exernally
+    using PCIeBinding::endpointInterface;
     using PCIeBinding::hw;
     using PCIeBinding::hwMonitor;
+    using PCIeBinding::processRoutingTableChanges;
+    using PCIeBinding::registrationConcurrency;
+    using PCIeBinding::routingTableEntry_t;
 };
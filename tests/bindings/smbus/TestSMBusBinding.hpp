@@ -0,0 +1,61 @@
+#pragma once
+
+#include "SMBusBinding.hpp"
+#include "mocks/objectServerMock.hpp"
+#include "utils/BindingBackdoor.hpp"
+
+/*
+ * SMBus binding registered on top of fake driver instead of i2c devices.
+ * Bus is not scanned, devices are passed to registerDevices directly.
+ */
+class TestSMBusBinding : public SMBusBinding
+{
+    static constexpr size_t packetSize = 4096;
+
+  public:
+    using PrvDataType = mctp_smbus_pkt_private;
+    using Backdoor = BindingBackdoor<PrvDataType>;
+
+    TestSMBusBinding(std::shared_ptr<sdbusplus::asio::connection> conn,
+                     std::shared_ptr<object_server>& objServer,
+                     const std::string& objPath, SMBusConfiguration& conf,
+                     boost::asio::io_context& ioc) :
+        SMBusBinding(conn, objServer, objPath, conf, ioc, nullptr),
+        driver(packetSize, sizeof(PrvDataType)), backdoor(driver)
+    {
+    }
+
+    ~TestSMBusBinding() override = default;
+
+    void initializeBinding() override
+    {
+        initializeMctp();
+
+        struct mctp_binding* binding = &driver.binding;
+        if (0 > mctp_register_bus(mctp, binding, ownEid))
+        {
+            throw std::runtime_error("mctp_register_bus failed");
+        }
+        mctp_set_rx_all(mctp, &MctpBinding::rxMessage,
+                        static_cast<MctpBinding*>(this));
+        mctp_set_rx_ctrl(mctp, &MctpBinding::handleMCTPControlRequests,
+                         static_cast<MctpBinding*>(this));
+        mctp_binding_set_tx_enabled(binding, true);
+    }
+
+    bool isPipelinedRegistrationAllowed(
+        const mctpd::BindingPrivate& privateData) override
+    {
+        return pipelinedRegistration.value_or(
+            SMBusBinding::isPipelinedRegistrationAllowed(privateData));
+    }
+
+    mctp_binding_fake driver;
+    Backdoor backdoor;
+    // Overrides decision of the binding, which depends on mux ports
+    std::optional<bool> pipelinedRegistration;
+
+    // Extract protected members exernally
+    using SMBusBinding::endpointInterface;
+    using SMBusBinding::registerDevices;
+};
@@ -2,6 +2,7 @@
 
 #include <functional>
 #include <list>
+#include <stdexcept>
 #include <vector>
 
 #include "libmctp.h"
@@ -136,6 +137,10 @@ struct mctp_binding_fake
     mctp_binding binding{};
     frame_log log;
     frame_matchers matchers;
+    // Result returned by binding tx, negative value simulates failed write
+    int txResult = 0;
+    // Takes over transmitted packets instead of the log, when set
+    std::function<int(mctp_binding*, mctp_pktbuf*)> txHandler;
 
     mctp_binding_fake(const size_t packet_size, const size_t prv_size)
     {
@@ -152,6 +157,14 @@ struct mctp_binding_fake
     static int tx(struct mctp_binding* binding, struct mctp_pktbuf* pkt)
     {
         auto driver = container_of(binding, mctp_binding_fake, binding);
+        if (driver->txResult < 0)
+        {
+            return driver->txResult;
+        }
+        if (driver->txHandler)
+        {
+            return driver->txHandler(binding, pkt);
+        }
         driver->log.tx.push_back(toMctpFrame(binding, pkt));
         driver->matchers.check(driver->log.tx.back());
         return 0;
@@ -0,0 +1,105 @@
+#include "utils/async_join.hpp"
+
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+static boost::asio::awaitable<int> delayedValue(std::chrono::milliseconds delay,
+                                                int value,
+                                                std::vector<int>& finished)
+{
+    boost::asio::steady_timer timer(co_await boost::asio::this_coro::executor);
+    timer.expires_after(delay);
+    co_await timer.async_wait(boost::asio::use_awaitable);
+    finished.push_back(value);
+    co_return value;
+}
+
+TEST(AsyncJoinTest, CompletesAfterAllOperationsRanConcurrently)
+{
+    boost::asio::io_context io;
+    std::vector<int> finished;
+    int slow = 0;
+    int fast = 0;
+    bool joined = false;
+
+    boost::asio::co_spawn(
+        io,
+        [&]() -> boost::asio::awaitable<void> {
+            std::vector<boost::asio::awaitable<void>> ops;
+            ops.push_back(mctpd::assignResult(
+                delayedValue(20ms, 1, finished), slow));
+            ops.push_back(
+                mctpd::assignResult(delayedValue(0ms, 2, finished), fast));
+            co_await mctpd::asyncJoin(io.get_executor(), std::move(ops),
+                                      boost::asio::use_awaitable);
+            joined = true;
+        },
+        boost::asio::detached);
+    io.run();
+
+    EXPECT_TRUE(joined);
+    EXPECT_EQ(1, slow);
+    EXPECT_EQ(2, fast);
+    EXPECT_EQ((std::vector<int>{2, 1}), finished);
+}
+
+TEST(AsyncJoinTest, RethrowsExceptionOnceAllOperationsFinished)
+{
+    boost::asio::io_context io;
+    std::vector<int> finished;
+    int value = 0;
+    std::string error;
+
+    boost::asio::co_spawn(
+        io,
+        [&]() -> boost::asio::awaitable<void> {
+            std::vector<boost::asio::awaitable<void>> ops;
+            ops.push_back([]() -> boost::asio::awaitable<void> {
+                throw std::runtime_error("failed");
+                co_return;
+            }());
+            ops.push_back(
+                mctpd::assignResult(delayedValue(10ms, 1, finished), value));
+            try
+            {
+                co_await mctpd::asyncJoin(io.get_executor(), std::move(ops),
+                                          boost::asio::use_awaitable);
+            }
+            catch (const std::runtime_error& e)
+            {
+                error = e.what();
+            }
+        },
+        boost::asio::detached);
+    io.run();
+
+    EXPECT_EQ("failed", error);
+    EXPECT_EQ(1, value);
+}
+
+TEST(AsyncJoinTest, EmptyJoinCompletes)
+{
+    boost::asio::io_context io;
+    bool joined = false;
+
+    boost::asio::co_spawn(
+        io,
+        [&]() -> boost::asio::awaitable<void> {
+            co_await mctpd::asyncJoin(io.get_executor(), {},
+                                      boost::asio::use_awaitable);
+            joined = true;
+        },
+        boost::asio::detached);
+    io.run();
+
+    EXPECT_TRUE(joined);
+}
@@ -1,4 +1,6 @@
 #include "bindings/TestBinding.hpp"
+#include "libmctp-msgtypes.h"
+#include "mctp_cmd_encoder.hpp"
 #include "utils/AsyncTestBase.hpp"
 
 #include <gtest/gtest.h>
@@ -44,10 +46,11 @@ TEST_F(BindingBasicTest, Send_GetEid_Positive)
     constexpr unsigned RESP_MEDIUM_DATA = 12;
 
     auto getEid = makePromise<std::tuple<bool, std::vector<uint8_t>>>();
-    schedule([&](boost::asio::yield_context yield) {
-        std::vector<uint8_t> prv, resp;
+    schedule([&]() -> boost::asio::awaitable<void> {
+        mctpd::BindingPrivate prv;
+        std::vector<uint8_t> resp;
 
-        bool result = binding->getEidCtrlCmd(yield, prv, DEST_EID, resp);
+        bool result = co_await binding->getEidCtrlCmd(prv, DEST_EID, resp);
         getEid.promise.set_value({result, resp});
     });
 
@@ -84,9 +87,10 @@ TEST_F(BindingBasicTest, Send_GetEid_Negative)
     constexpr unsigned CC_FAIL = 255;
 
     auto getEid = makePromise<std::tuple<bool, std::vector<uint8_t>>>();
-    schedule([&](boost::asio::yield_context yield) {
-        std::vector<uint8_t> prv, resp;
-        bool result = binding->getEidCtrlCmd(yield, prv, DEST_EID, resp);
+    schedule([&]() -> boost::asio::awaitable<void> {
+        mctpd::BindingPrivate prv;
+        std::vector<uint8_t> resp;
+        bool result = co_await binding->getEidCtrlCmd(prv, DEST_EID, resp);
         getEid.promise.set_value({result, resp});
     });
 
@@ -114,10 +118,11 @@ TEST_F(BindingBasicTest, Send_GetEid_Timeout)
     constexpr unsigned DEST_EID = 10;
 
     auto getEid = makePromise<std::tuple<bool, std::vector<uint8_t>>>();
-    schedule([&](boost::asio::yield_context yield) {
-        std::vector<uint8_t> prv, resp;
+    schedule([&]() -> boost::asio::awaitable<void> {
+        mctpd::BindingPrivate prv;
+        std::vector<uint8_t> resp;
 
-        bool result = binding->getEidCtrlCmd(yield, prv, DEST_EID, resp);
+        bool result = co_await binding->getEidCtrlCmd(prv, DEST_EID, resp);
         getEid.promise.set_value({result, resp});
     });
 
@@ -128,3 +133,255 @@ TEST_F(BindingBasicTest, Send_GetEid_Timeout)
         ASSERT_EQ(0, resp.size());
     }
 }
+
+TEST_F(BindingBasicTest, Send_GetEid_WakesUpOnlyAtDeadlines)
+{
+    constexpr unsigned DEST_EID = 10;
+    constexpr uint8_t RETRY_COUNT = 2;
+
+    Configuration config{};
+    config.reqRetryCount = RETRY_COUNT;
+    config.reqToRespTime = std::chrono::milliseconds{messageTimeout}.count() /
+                           (RETRY_COUNT + 1);
+    binding = std::make_shared<TestBinding>(
+        conn, bus, "/xyz/openbmc_project/test_mctp", config, ioc);
+    binding->initializeBinding();
+
+    auto getEid = makePromise<bool>();
+    schedule([&]() -> boost::asio::awaitable<void> {
+        mctpd::BindingPrivate prv;
+        std::vector<uint8_t> resp;
+        getEid.promise.set_value(
+            co_await binding->getEidCtrlCmd(prv, DEST_EID, resp));
+    });
+
+    // One wakeup per retransmission and one for final expiration, instead
+    // of polling every few milliseconds
+    ASSERT_FALSE(waitFor(getEid.future));
+    EXPECT_EQ(size_t{RETRY_COUNT} + 1, binding->driver.log.tx.size());
+    EXPECT_EQ(size_t{RETRY_COUNT} + 1, binding->ctrlTxTimerWakeups);
+}
+
+TEST_F(BindingBasicTest, Send_GetEid_DiscoveryPolicyDeadlineStopsRetries)
+{
+    constexpr unsigned DEST_EID = 10;
+    constexpr uint8_t RETRY_COUNT = 100;
+    constexpr auto timeout = std::chrono::milliseconds{messageTimeout} / 8;
+
+    Configuration config{};
+    config.reqRetryCount = 0;
+    config.reqToRespTime = std::chrono::milliseconds{messageTimeout}.count();
+    mctpd::RetryPolicy discovery;
+    discovery.timeout = timeout;
+    discovery.retryCount = RETRY_COUNT;
+    discovery.deadline = timeout * 3;
+    config.ctrlRetryPolicies.emplace(mctpd::CtrlCommandClass::discovery,
+                                     discovery);
+    binding = std::make_shared<TestBinding>(
+        conn, bus, "/xyz/openbmc_project/test_mctp", config, ioc);
+    binding->initializeBinding();
+
+    auto getEid = makePromise<bool>();
+    schedule([&]() -> boost::asio::awaitable<void> {
+        mctpd::BindingPrivate prv;
+        std::vector<uint8_t> resp;
+        getEid.promise.set_value(
+            co_await binding->getEidCtrlCmd(prv, DEST_EID, resp));
+    });
+
+    // Retransmitted at every timeout until deadline, not RETRY_COUNT times
+    ASSERT_FALSE(waitFor(getEid.future));
+    EXPECT_EQ(3u, binding->driver.log.tx.size());
+}
+
+TEST_F(BindingBasicTest, Send_GetEid_ResponseFromOtherEidIsIgnored)
+{
+    constexpr unsigned DEST_EID = 10;
+    constexpr unsigned OTHER_EID = 11;
+    constexpr unsigned CC_OK = 0;
+    constexpr unsigned RESP_EID = 99;
+
+    auto getEid = makePromise<std::tuple<bool, std::vector<uint8_t>>>();
+    schedule([&]() -> boost::asio::awaitable<void> {
+        mctpd::BindingPrivate prv;
+        std::vector<uint8_t> resp;
+        bool result = co_await binding->getEidCtrlCmd(prv, DEST_EID, resp);
+        getEid.promise.set_value({result, resp});
+    });
+
+    // Same instance ID, but different message terminus
+    schedule([&]() {
+        auto response =
+            binding->backdoor.prepareCtrlResponse<mctp_ctrl_resp_get_eid>();
+        response.hdr->src = OTHER_EID;
+        response.payload->completion_code = CC_OK;
+        response.payload->eid = OTHER_EID;
+        binding->backdoor.rx(response);
+    });
+
+    schedule([&]() {
+        auto response =
+            binding->backdoor.prepareCtrlResponse<mctp_ctrl_resp_get_eid>();
+        response.payload->completion_code = CC_OK;
+        response.payload->eid = RESP_EID;
+        binding->backdoor.rx(response);
+    });
+
+    {
+        const auto [result, resp] = waitFor(getEid.future);
+        ASSERT_TRUE(result);
+        ASSERT_EQ(resp.size(), sizeof(mctp_ctrl_resp_get_eid));
+
+        auto response =
+            reinterpret_cast<const mctp_ctrl_resp_get_eid*>(resp.data());
+        ASSERT_EQ(response->eid, RESP_EID);
+    }
+}
+
+TEST_F(BindingBasicTest, AsyncCtrlRequest_CompletesOnceWithResponse)
+{
+    constexpr unsigned DEST_EID = 10;
+    constexpr unsigned CC_OK = 0;
+    constexpr unsigned RESP_EID = 99;
+
+    auto req = getFormattedReq<MCTP_CTRL_CMD_GET_ENDPOINT_ID>();
+    ASSERT_TRUE(req);
+
+    size_t completions = 0;
+    auto getEid = makePromise<
+        std::tuple<boost::system::error_code, std::vector<uint8_t>>>();
+    binding->asyncSendAndRcvMctpCtrl(
+        *req, DEST_EID, {},
+        [&](boost::system::error_code ec, std::vector<uint8_t> resp) {
+            if (completions++ == 0)
+            {
+                getEid.promise.set_value({ec, std::move(resp)});
+            }
+        });
+
+    schedule([&]() {
+        auto response =
+            binding->backdoor.prepareCtrlResponse<mctp_ctrl_resp_get_eid>();
+        response.payload->completion_code = CC_OK;
+        response.payload->eid = RESP_EID;
+        binding->backdoor.rx(response);
+    });
+
+    const auto [ec, resp] = waitFor(getEid.future);
+    EXPECT_FALSE(ec);
+    ASSERT_EQ(resp.size(), sizeof(mctp_ctrl_resp_get_eid));
+    auto response =
+        reinterpret_cast<const mctp_ctrl_resp_get_eid*>(resp.data());
+    EXPECT_EQ(RESP_EID, response->eid);
+
+    // No retransmission or expiration after response
+    ioc.run_for(std::chrono::milliseconds{messageTimeout * 2});
+    EXPECT_EQ(1u, completions);
+    EXPECT_EQ(1u, binding->driver.log.tx.size());
+}
+
+TEST_F(BindingBasicTest, SendReceive_ExpiredWhileQueuedIsShed)
+{
+    constexpr unsigned DEST_EID = 10;
+    constexpr size_t TAG_COUNT = 8;
+    constexpr auto shortTimeout = std::chrono::milliseconds{messageTimeout} / 4;
+
+    // Requests holding every tag outlive the one queued behind them
+    std::vector<std::errc> errors;
+    auto allDone = makePromise<void>();
+    auto sendReceive = [&](std::chrono::milliseconds timeout) {
+        schedule([&, timeout](boost::asio::yield_context yield) {
+            try
+            {
+                binding->sendReceiveMctpMessagePayload(
+                    yield, DEST_EID, {MCTP_MESSAGE_TYPE_VDPCI, 0x01},
+                    static_cast<uint16_t>(timeout.count()));
+            }
+            catch (const std::system_error& e)
+            {
+                errors.push_back(static_cast<std::errc>(e.code().value()));
+            }
+            if (errors.size() == TAG_COUNT + 1)
+            {
+                allDone.promise.set_value();
+            }
+        });
+    };
+    for (size_t i = 0; i < TAG_COUNT; ++i)
+    {
+        sendReceive(std::chrono::milliseconds{messageTimeout});
+    }
+    sendReceive(shortTimeout);
+
+    waitFor(allDone.future);
+    ASSERT_EQ(TAG_COUNT + 1, errors.size());
+    EXPECT_EQ(std::errc::timed_out, errors.front());
+    EXPECT_EQ(TAG_COUNT, binding->driver.log.tx.size());
+
+    const auto statistics = binding->transmissionQueue.getStatistics();
+    ASSERT_EQ(1u, statistics.count(DEST_EID));
+    EXPECT_EQ(TAG_COUNT, statistics.at(DEST_EID).transmittedMessages);
+    EXPECT_EQ(1u, statistics.at(DEST_EID).shedMessages);
+}
+
+TEST_F(BindingBasicTest, AsyncCtrlRequest_WaitsForFreeTag)
+{
+    constexpr unsigned DEST_EID = 10;
+    constexpr size_t TAG_COUNT = 8;
+    constexpr unsigned CC_OK = 0;
+
+    auto req = getFormattedReq<MCTP_CTRL_CMD_GET_ENDPOINT_ID>();
+    ASSERT_TRUE(req);
+
+    std::vector<boost::system::error_code> completions;
+    for (size_t i = 0; i < TAG_COUNT + 1; i++)
+    {
+        binding->asyncSendAndRcvMctpCtrl(
+            *req, DEST_EID, {},
+            [&completions](boost::system::error_code ec,
+                           std::vector<uint8_t>) {
+                completions.push_back(ec);
+            });
+    }
+    ioc.poll();
+    ioc.restart();
+
+    // Last request is not failed, it waits until a tag is released
+    EXPECT_TRUE(completions.empty());
+    ASSERT_EQ(TAG_COUNT, binding->driver.log.tx.size());
+
+    auto response = binding->backdoor.prepareCtrlResponse<
+        mctp_ctrl_resp_get_eid>(binding->driver.log.tx.front());
+    response.payload->completion_code = CC_OK;
+    binding->backdoor.rx(response);
+    ioc.poll();
+
+    ASSERT_EQ(1u, completions.size());
+    EXPECT_FALSE(completions.front());
+    EXPECT_EQ(TAG_COUNT + 1, binding->driver.log.tx.size());
+}
+
+TEST_F(BindingBasicTest, AsyncCtrlRequest_TagWaitEndsAtDeadline)
+{
+    constexpr unsigned DEST_EID = 10;
+    constexpr size_t TAG_COUNT = 8;
+
+    // Tags held by messages which are never completed, e.g. quarantined
+    for (size_t i = 0; i < TAG_COUNT; i++)
+    {
+        ASSERT_TRUE(binding->correlator->allocateTag(DEST_EID));
+    }
+
+    auto req = getFormattedReq<MCTP_CTRL_CMD_GET_ENDPOINT_ID>();
+    ASSERT_TRUE(req);
+    auto done = makePromise<boost::system::error_code>();
+    binding->asyncSendAndRcvMctpCtrl(
+        *req, DEST_EID, {},
+        [&done](boost::system::error_code ec, std::vector<uint8_t>) {
+            done.promise.set_value(ec);
+        });
+
+    // Completes with no response instead of waiting for a tag forever
+    EXPECT_EQ(boost::asio::error::timed_out, waitFor(done.future));
+    EXPECT_TRUE(binding->driver.log.tx.empty());
+}
@@ -0,0 +1,167 @@
+#include "utils/capability_cache.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+static const std::string uuid = "ba5eba11-0000-4000-8000-000000000001";
+
+class CapabilityCacheTest : public ::testing::Test
+{
+  protected:
+    CapabilityCacheTest()
+    {
+        dir = std::filesystem::temp_directory_path() /
+              ("test-capability_cache-" + std::to_string(getpid()));
+        file = dir / "cache";
+        entry.controlVersions = {{0xF1, 0xF3, 0xF1, 0x00}};
+        entry.msgTypes = {0x00, 0x01, 0x7E};
+        entry.vendorIdFormat = "0x8086";
+        entry.vendorIdCapabilitySets = {0x1234, 0x5678};
+    }
+
+    ~CapabilityCacheTest()
+    {
+        std::filesystem::remove_all(dir);
+    }
+
+    std::vector<uint8_t> readFile()
+    {
+        std::ifstream in(file, std::ios::binary);
+        return {std::istreambuf_iterator<char>(in),
+                std::istreambuf_iterator<char>()};
+    }
+
+    void writeFile(const std::vector<uint8_t>& data)
+    {
+        std::ofstream out(file, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(data.data()),
+                  static_cast<std::streamsize>(data.size()));
+    }
+
+    boost::asio::io_context io;
+    std::filesystem::path dir;
+    std::filesystem::path file;
+    mctpd::CapabilityCache::Entry entry;
+};
+
+TEST_F(CapabilityCacheTest, EntriesAreLoadedAfterRestart)
+{
+    mctpd::CapabilityCache cache(io);
+    EXPECT_FALSE(cache.load(file));
+    cache.store(uuid, entry);
+    EXPECT_EQ(entry, cache.find(uuid));
+    cache.flush();
+
+    mctpd::CapabilityCache restarted(io);
+    ASSERT_TRUE(restarted.load(file));
+    EXPECT_EQ(entry, restarted.find(uuid));
+    EXPECT_FALSE(restarted.find("unknown"));
+}
+
+TEST_F(CapabilityCacheTest, CorruptedFileIsIgnored)
+{
+    mctpd::CapabilityCache cache(io);
+    cache.load(file);
+    cache.store(uuid, entry);
+    cache.flush();
+
+    auto data = readFile();
+    data.back() ^= 0xFF;
+    writeFile(data);
+    mctpd::CapabilityCache restarted(io);
+    EXPECT_FALSE(restarted.load(file));
+    EXPECT_FALSE(restarted.find(uuid));
+
+    data.pop_back();
+    writeFile(data);
+    EXPECT_FALSE(restarted.load(file));
+}
+
+TEST_F(CapabilityCacheTest, OtherFormatVersionIsIgnored)
+{
+    mctpd::CapabilityCache cache(io);
+    cache.load(file);
+    cache.store(uuid, entry);
+    cache.flush();
+
+    auto data = readFile();
+    // Format version follows 4 byte magic
+    data[4] = mctpd::CapabilityCache::formatVersion + 1;
+    writeFile(data);
+    mctpd::CapabilityCache restarted(io);
+    EXPECT_FALSE(restarted.load(file));
+
+    // Next store rewrites file in current format
+    restarted.store(uuid, entry);
+    restarted.flush();
+    EXPECT_TRUE(cache.load(file));
+    EXPECT_EQ(entry, cache.find(uuid));
+}
+
+TEST_F(CapabilityCacheTest, DisabledCacheDoesNotStore)
+{
+    mctpd::CapabilityCache cache(io);
+    EXPECT_FALSE(cache.isEnabled());
+    cache.store(uuid, entry);
+    EXPECT_FALSE(cache.find(uuid));
+}
+
+TEST_F(CapabilityCacheTest, StoresAreWrittenOnceSettled)
+{
+    mctpd::CapabilityCache cache(io, mctpd::CapabilityCache::defaultMaxEntries,
+                                 std::chrono::milliseconds(20));
+    cache.load(file);
+    for (int i = 0; i < 10; i++)
+    {
+        cache.store(uuid + std::to_string(i), entry);
+    }
+    EXPECT_FALSE(std::filesystem::exists(file));
+
+    io.run_for(std::chrono::milliseconds(100));
+    mctpd::CapabilityCache restarted(io);
+    ASSERT_TRUE(restarted.load(file));
+    for (int i = 0; i < 10; i++)
+    {
+        EXPECT_EQ(entry, restarted.find(uuid + std::to_string(i)));
+    }
+}
+
+TEST_F(CapabilityCacheTest, PendingStoresAreWrittenOnDestruction)
+{
+    {
+        mctpd::CapabilityCache cache(io);
+        cache.load(file);
+        cache.store(uuid, entry);
+    }
+    mctpd::CapabilityCache restarted(io);
+    ASSERT_TRUE(restarted.load(file));
+    EXPECT_EQ(entry, restarted.find(uuid));
+}
+
+TEST_F(CapabilityCacheTest, LeastRecentlyStoredIsEvicted)
+{
+    mctpd::CapabilityCache cache(io, 2);
+    cache.load(file);
+    cache.store(uuid + "0", entry);
+    cache.store(uuid + "1", entry);
+    // Unchanged store still marks endpoint as recently seen
+    cache.store(uuid + "0", entry);
+    cache.store(uuid + "2", entry);
+    EXPECT_TRUE(cache.find(uuid + "0"));
+    EXPECT_FALSE(cache.find(uuid + "1"));
+    EXPECT_TRUE(cache.find(uuid + "2"));
+    cache.flush();
+
+    // Entries not stored since restart are evicted first
+    mctpd::CapabilityCache restarted(io, 2);
+    ASSERT_TRUE(restarted.load(file));
+    restarted.store(uuid + "2", entry);
+    restarted.store(uuid + "3", entry);
+    EXPECT_FALSE(restarted.find(uuid + "0"));
+    EXPECT_TRUE(restarted.find(uuid + "2"));
+    EXPECT_TRUE(restarted.find(uuid + "3"));
+}
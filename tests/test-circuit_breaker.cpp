@@ -0,0 +1,79 @@
+#include "utils/circuit_breaker.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+using State = mctpd::CircuitBreaker::State;
+
+TEST(CircuitBreakerTest, OpensAfterConsecutiveTimeouts)
+{
+    constexpr mctp_eid_t EID = 10;
+    constexpr mctp_eid_t OTHER_EID = 11;
+
+    mctpd::CircuitBreaker breaker;
+    breaker.setPolicy(3, 1000s);
+
+    breaker.onTimeout(EID);
+    breaker.onTimeout(EID);
+    breaker.onSuccess(EID);
+    breaker.onTimeout(EID);
+    breaker.onTimeout(EID);
+    EXPECT_TRUE(breaker.allowRequest(EID));
+
+    breaker.onTimeout(EID);
+    EXPECT_EQ(State::open, breaker.getState(EID));
+    EXPECT_FALSE(breaker.allowRequest(EID));
+    EXPECT_TRUE(breaker.allowRequest(OTHER_EID));
+}
+
+TEST(CircuitBreakerTest, SingleProbeClosesBreakerOnSuccess)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    std::vector<State> states;
+    mctpd::CircuitBreaker breaker;
+    breaker.setPolicy(1, 0ms);
+    breaker.setStateObserver(
+        [&states](mctp_eid_t, State state) { states.push_back(state); });
+
+    breaker.onTimeout(EID);
+    EXPECT_TRUE(breaker.allowRequest(EID));
+    EXPECT_EQ(State::halfOpen, breaker.getState(EID));
+
+    breaker.onSuccess(EID);
+    EXPECT_EQ(State::closed, breaker.getState(EID));
+    EXPECT_EQ((std::vector<State>{State::open, State::halfOpen, State::closed}),
+              states);
+}
+
+TEST(CircuitBreakerTest, FailedProbeOpensBreakerAgain)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    mctpd::CircuitBreaker breaker;
+    breaker.setPolicy(2, 0ms);
+    breaker.onTimeout(EID);
+    breaker.onTimeout(EID);
+    ASSERT_TRUE(breaker.allowRequest(EID));
+
+    breaker.setPolicy(2, 1000s);
+    breaker.onTimeout(EID);
+    EXPECT_EQ(State::open, breaker.getState(EID));
+    EXPECT_FALSE(breaker.allowRequest(EID));
+}
+
+TEST(CircuitBreakerTest, ZeroThresholdDisablesBreaker)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    mctpd::CircuitBreaker breaker;
+    breaker.setPolicy(0, 1000s);
+    for (int i = 0; i < 100; i++)
+    {
+        breaker.onTimeout(EID);
+    }
+    EXPECT_TRUE(breaker.allowRequest(EID));
+    EXPECT_EQ(State::closed, breaker.getState(EID));
+}
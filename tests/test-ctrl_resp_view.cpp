@@ -0,0 +1,75 @@
+#include "utils/ctrl_resp_view.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+// Control message header of a response, completion code follows it
+static std::vector<uint8_t> makeResponse(uint8_t commandCode,
+                                         std::vector<uint8_t> payload)
+{
+    std::vector<uint8_t> resp{0x00, 0x00, commandCode};
+    resp.insert(resp.end(), payload.begin(), payload.end());
+    return resp;
+}
+
+TEST(CtrlRespViewTest, MessageTypesAreDecodedInPlace)
+{
+    const auto resp = makeResponse(MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT,
+                                   {MCTP_CTRL_CC_SUCCESS, 2, 0x00, 0x01});
+
+    const auto view = mctpd::MsgTypeSupportView::decode(resp);
+    ASSERT_TRUE(view);
+    EXPECT_EQ(resp.data() + 5, view->msgTypes().data());
+    EXPECT_EQ((std::vector<uint8_t>{0x00, 0x01}),
+              std::vector<uint8_t>(view->msgTypes().begin(),
+                                   view->msgTypes().end()));
+}
+
+TEST(CtrlRespViewTest, ListNotMatchingItsCountIsRejected)
+{
+    EXPECT_FALSE(mctpd::MsgTypeSupportView::decode(
+        makeResponse(MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT,
+                     {MCTP_CTRL_CC_SUCCESS, 3, 0x00, 0x01})));
+    EXPECT_FALSE(mctpd::MsgTypeSupportView::decode(makeResponse(
+        MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT, {MCTP_CTRL_CC_SUCCESS, 0})));
+    EXPECT_FALSE(mctpd::VersionSupportView::decode(
+        makeResponse(MCTP_CTRL_CMD_GET_VERSION_SUPPORT,
+                     {MCTP_CTRL_CC_SUCCESS, 1, 0xF1, 0xF3, 0xF1})));
+    EXPECT_FALSE(mctpd::VersionSupportView::decode(
+        makeResponse(MCTP_CTRL_CMD_GET_VERSION_SUPPORT, {})));
+}
+
+TEST(CtrlRespViewTest, ErrorCompletionCodeIsRejected)
+{
+    constexpr uint8_t CC_ERROR = 0x01;
+
+    EXPECT_FALSE(mctpd::MsgTypeSupportView::decode(makeResponse(
+        MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT, {CC_ERROR, 1, 0x00})));
+    EXPECT_FALSE(mctpd::CtrlRespView::decode(
+        makeResponse(MCTP_CTRL_CMD_GET_ENDPOINT_ID, {CC_ERROR}), 4));
+}
+
+TEST(CtrlRespViewTest, VersionsAndVendorIdSetAreDecoded)
+{
+    const auto versions =
+        makeResponse(MCTP_CTRL_CMD_GET_VERSION_SUPPORT,
+                     {MCTP_CTRL_CC_SUCCESS, 2, 0xF1, 0xF2, 0xF0, 0x00, 0xF1,
+                      0xF3, 0xF1, 0x00});
+    const auto versionView = mctpd::VersionSupportView::decode(versions);
+    ASSERT_TRUE(versionView);
+    ASSERT_EQ(2u, versionView->count());
+    EXPECT_EQ(0xF3, versionView->version(1).minor);
+    EXPECT_EQ(0xF1, versionView->version(1).update);
+
+    const auto vdm = makeResponse(
+        MCTP_CTRL_CMD_GET_VENDOR_MESSAGE_SUPPORT,
+        {MCTP_CTRL_CC_SUCCESS, 0xFF, 0x00, 0x80, 0x86, 0x12, 0x34});
+    const auto vdmView = mctpd::VdmSupportView::decode(vdm);
+    ASSERT_TRUE(vdmView);
+    EXPECT_EQ(0xFF, vdmView->vendorIdSet());
+    EXPECT_EQ(0x8086, vdmView->vendorIdFormatData());
+    EXPECT_EQ(0x1234, vdmView->commandSetType());
+    EXPECT_FALSE(mctpd::VdmSupportView::decode(
+        std::span<const uint8_t>(vdm).first(vdm.size() - 1)));
+}
@@ -0,0 +1,48 @@
+#include "utils/instance_id_pool.hpp"
+
+#include <gtest/gtest.h>
+
+TEST(InstanceIdPoolTest, DestinationsAllocateIndependently)
+{
+    constexpr mctp_eid_t EID_A = 10;
+    constexpr mctp_eid_t EID_B = 11;
+
+    mctpd::InstanceIdPool pool;
+    for (uint8_t i = 0; i < mctpd::InstanceIdPool::instanceIdCount; i++)
+    {
+        ASSERT_TRUE(pool.allocate(EID_A));
+    }
+    EXPECT_FALSE(pool.allocate(EID_A));
+    EXPECT_TRUE(pool.allocate(EID_B));
+    EXPECT_EQ(mctpd::InstanceIdPool::instanceIdCount, pool.inUse(EID_A));
+    EXPECT_EQ(1u, pool.inUse(EID_B));
+}
+
+TEST(InstanceIdPoolTest, ReleasedIdIsNotReusedImmediately)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    mctpd::InstanceIdPool pool;
+    const auto first = pool.allocate(EID);
+    ASSERT_TRUE(first);
+    pool.release(EID, *first);
+    EXPECT_EQ(0u, pool.inUse(EID));
+
+    const auto second = pool.allocate(EID);
+    ASSERT_TRUE(second);
+    EXPECT_NE(*first, *second);
+}
+
+TEST(InstanceIdPoolTest, ReleasedIdCanBeAllocatedAgain)
+{
+    constexpr mctp_eid_t EID = 10;
+    constexpr uint8_t RELEASED = 5;
+
+    mctpd::InstanceIdPool pool;
+    for (uint8_t i = 0; i < mctpd::InstanceIdPool::instanceIdCount; i++)
+    {
+        ASSERT_EQ(i, pool.allocate(EID));
+    }
+    pool.release(EID, RELEASED);
+    EXPECT_EQ(RELEASED, pool.allocate(EID));
+}
@@ -0,0 +1,50 @@
+#include "utils/retry_policy.hpp"
+
+#include <set>
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(RetryPolicyTest, TimeoutBacksOffUpToMaxTimeout)
+{
+    std::minstd_rand random;
+    mctpd::RetryPolicy policy;
+    policy.timeout = 100ms;
+    policy.backoffFactor = 2;
+    policy.maxTimeout = 500ms;
+
+    EXPECT_EQ(100ms, policy.getTimeout(0, random));
+    EXPECT_EQ(200ms, policy.getTimeout(1, random));
+    EXPECT_EQ(400ms, policy.getTimeout(2, random));
+    EXPECT_EQ(500ms, policy.getTimeout(3, random));
+    EXPECT_EQ(500ms, policy.getTimeout(200, random));
+}
+
+TEST(RetryPolicyTest, DefaultPolicyKeepsFixedTimeout)
+{
+    std::minstd_rand random;
+    mctpd::RetryPolicy policy;
+    policy.timeout = 100ms;
+
+    EXPECT_EQ(100ms, policy.getTimeout(0, random));
+    EXPECT_EQ(100ms, policy.getTimeout(5, random));
+}
+
+TEST(RetryPolicyTest, JitterStaysWithinBoundsAndSpreadsTimeouts)
+{
+    std::minstd_rand random;
+    mctpd::RetryPolicy policy;
+    policy.timeout = 100ms;
+    policy.jitterPercent = 20;
+
+    std::set<std::chrono::milliseconds::rep> timeouts;
+    for (int i = 0; i < 100; i++)
+    {
+        const auto timeout = policy.getTimeout(0, random);
+        EXPECT_GE(timeout, 80ms);
+        EXPECT_LE(timeout, 120ms);
+        timeouts.insert(timeout.count());
+    }
+    EXPECT_GT(timeouts.size(), 1u);
+}
@@ -0,0 +1,60 @@
+#include "utils/rtt_estimator.hpp"
+
+#include <gtest/gtest.h>
+
+using namespace std::chrono_literals;
+
+TEST(RttEstimatorTest, FirstSampleSetsEstimate)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    mctpd::RttEstimator estimator;
+    EXPECT_FALSE(estimator.getEstimate(EID));
+
+    estimator.addSample(EID, 20ms);
+    const auto estimate = estimator.getEstimate(EID);
+    ASSERT_TRUE(estimate);
+    EXPECT_EQ(20ms, estimate->smoothedRtt);
+    EXPECT_EQ(10ms, estimate->rttVariance);
+    EXPECT_EQ(60ms, estimate->timeout);
+}
+
+TEST(RttEstimatorTest, StableRttNarrowsTimeout)
+{
+    constexpr mctp_eid_t FAST_EID = 10;
+    constexpr mctp_eid_t SLOW_EID = 11;
+
+    mctpd::RttEstimator estimator;
+    for (int i = 0; i < 50; i++)
+    {
+        estimator.addSample(FAST_EID, 2ms);
+        estimator.addSample(SLOW_EID, 400ms);
+    }
+
+    EXPECT_EQ(10ms, estimator.getEstimate(FAST_EID)->timeout);
+    const auto slow = estimator.getEstimate(SLOW_EID).value();
+    EXPECT_EQ(400ms, slow.smoothedRtt);
+    EXPECT_GT(slow.timeout, 400ms);
+    EXPECT_LT(slow.timeout, 450ms);
+}
+
+TEST(RttEstimatorTest, TimeoutBacksOffUntilNextSample)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    mctpd::RttEstimator estimator;
+    estimator.setTimeoutLimits(1ms, 1000ms);
+    estimator.addSample(EID, 20ms);
+    const auto timeout = estimator.getEstimate(EID)->timeout;
+
+    estimator.addTimeout(EID);
+    EXPECT_EQ(timeout * 2, estimator.getEstimate(EID)->timeout);
+    for (int i = 0; i < 10; i++)
+    {
+        estimator.addTimeout(EID);
+    }
+    EXPECT_EQ(1000ms, estimator.getEstimate(EID)->timeout);
+
+    estimator.addSample(EID, 20ms);
+    EXPECT_LT(estimator.getEstimate(EID)->timeout, timeout * 2);
+}
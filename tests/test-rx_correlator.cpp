@@ -0,0 +1,117 @@
+#include "utils/rx_correlator.hpp"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+TEST(RxCorrelatorTest, TagsAreAllocatedPerDestination)
+{
+    constexpr mctp_eid_t EID_A = 10;
+    constexpr mctp_eid_t EID_B = 11;
+
+    mctpd::RxCorrelator correlator;
+    for (uint8_t i = 0; i < mctpd::RxCorrelator::tagCount; i++)
+    {
+        ASSERT_EQ(i, correlator.allocateTag(EID_A));
+    }
+    EXPECT_FALSE(correlator.hasFreeTag(EID_A));
+    EXPECT_FALSE(correlator.allocateTag(EID_A));
+    EXPECT_EQ(0, correlator.allocateTag(EID_B));
+
+    correlator.releaseTag(EID_A, 3);
+    EXPECT_EQ(3, correlator.allocateTag(EID_A));
+}
+
+TEST(RxCorrelatorTest, ResponseIsDeliveredOnlyToMatchingRequest)
+{
+    constexpr mctp_eid_t EID = 10;
+    constexpr mctp_eid_t OTHER_EID = 11;
+    const std::vector<uint8_t> response{0x01, 0x02};
+
+    mctpd::RxCorrelator correlator;
+    const uint8_t tag = correlator.allocateTag(EID).value();
+    size_t delivered = 0;
+    correlator.expect(EID, tag, [&delivered](std::span<const uint8_t>) {
+        delivered++;
+        return true;
+    });
+
+    EXPECT_FALSE(correlator.dispatch(OTHER_EID, tag, response));
+    EXPECT_FALSE(
+        correlator.dispatch(EID, static_cast<uint8_t>(tag + 1), response));
+    EXPECT_TRUE(correlator.dispatch(EID, tag, response));
+    EXPECT_FALSE(correlator.dispatch(EID, tag, response));
+    EXPECT_EQ(1u, delivered);
+    EXPECT_EQ(0u, correlator.pendingCount());
+}
+
+TEST(RxCorrelatorTest, RejectedResponseKeepsRequestPending)
+{
+    constexpr mctp_eid_t EID = 10;
+    const std::vector<uint8_t> stale{0x00};
+    const std::vector<uint8_t> response{0x01};
+
+    mctpd::RxCorrelator correlator;
+    const uint8_t tag = correlator.allocateTag(EID).value();
+    correlator.expect(EID, tag, [](std::span<const uint8_t> rx) {
+        return rx[0] == 0x01;
+    });
+
+    EXPECT_FALSE(correlator.dispatch(EID, tag, stale));
+    EXPECT_EQ(1u, correlator.pendingCount());
+    EXPECT_TRUE(correlator.dispatch(EID, tag, response));
+}
+
+TEST(RxCorrelatorTest, RequestToNullEidAcceptsAnySource)
+{
+    constexpr mctp_eid_t EID = 10;
+    const std::vector<uint8_t> response{0x01};
+
+    mctpd::RxCorrelator correlator;
+    const uint8_t tag = correlator.allocateTag(MCTP_EID_NULL).value();
+    correlator.expect(MCTP_EID_NULL, tag,
+                      [](std::span<const uint8_t>) { return true; });
+
+    EXPECT_TRUE(correlator.dispatch(EID, tag, response));
+    EXPECT_FALSE(correlator.dispatch(EID, tag, response));
+}
+
+TEST(RxCorrelatorTest, OneShotHandlerIsRemovedAfterFirstResponse)
+{
+    constexpr mctp_eid_t EID = 10;
+    const std::vector<uint8_t> response{0x01};
+
+    mctpd::RxCorrelator correlator;
+    const uint8_t tag = correlator.allocateTag(EID).value();
+    size_t delivered = 0;
+    correlator.expect(
+        EID, tag,
+        [&delivered](std::span<const uint8_t>) {
+            delivered++;
+            return false;
+        },
+        true);
+
+    EXPECT_FALSE(correlator.dispatch(EID, tag, response));
+    EXPECT_FALSE(correlator.dispatch(EID, tag, response));
+    EXPECT_EQ(1u, delivered);
+}
+
+TEST(RxCorrelatorTest, ObserverIsNotifiedOnceForReleasedTag)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    mctpd::RxCorrelator correlator;
+    std::vector<mctp_eid_t> released;
+    const size_t id = correlator.addReleaseObserver(
+        [&released](mctp_eid_t eid) { released.push_back(eid); });
+
+    const uint8_t tag = correlator.allocateTag(EID).value();
+    correlator.releaseTag(EID, tag);
+    correlator.releaseTag(EID, tag);
+    EXPECT_EQ((std::vector<mctp_eid_t>{EID}), released);
+
+    correlator.removeReleaseObserver(id);
+    correlator.releaseTag(EID, correlator.allocateTag(EID).value());
+    EXPECT_EQ(1u, released.size());
+}
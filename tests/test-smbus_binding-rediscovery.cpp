@@ -0,0 +1,222 @@
+#include "bindings/smbus/TestSMBusBinding.hpp"
+#include "utils/AsyncTestBase.hpp"
+#include "utils/DelayedResponder.hpp"
+
+#include "libmctp-msgtypes.h"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+/*
+ * Bus owner with single simulated device found by bus scan. Every control
+ * request sent to the device is recorded and answered asynchronously, as
+ * the device with its current EID would.
+ */
+class SMBusRediscoveryTest : public AsyncTestBase, public ::testing::Test
+{
+  public:
+    static constexpr uint8_t ownEid = 8;
+    static constexpr int deviceFd = 100;
+    static constexpr uint8_t deviceAddress = 0x10;
+
+    struct Request
+    {
+        mctp_eid_t dest;
+        uint8_t command;
+
+        bool operator==(const Request&) const = default;
+    };
+
+    SMBusRediscoveryTest()
+    {
+        bus = std::make_shared<mctpd_mock::object_server_mock>();
+
+        config.mediumId = mctp_server::MctpPhysicalMediumIdentifiers::Smbus;
+        config.mode = mctp_server::BindingModeTypes::BusOwner;
+        config.defaultEid = ownEid;
+        config.reqRetryCount = 0;
+        config.reqToRespTime =
+            std::chrono::milliseconds{executionTimeout / 2}.count();
+        config.bus = "/dev/i2c-1";
+        config.arpMasterSupport = false;
+        config.bmcSlaveAddr = 0x08;
+        config.routingIntervalSec = 0;
+        config.scanInterval = 0;
+        config.eidPool = {10, 11, 12};
+
+        binding = std::make_shared<TestSMBusBinding>(
+            conn, bus, "/xyz/openbmc_project/test_mctp", config, ioc);
+        binding->initializeBinding();
+        responder.emplace(ioc, binding->driver, std::chrono::microseconds{0},
+                          [this](const auto& request) { respond(request); });
+    }
+
+    // Runs registerDevices for the device until it returns
+    void scan()
+    {
+        const std::set<std::pair<int, uint8_t>> devices{
+            {deviceFd, deviceAddress}};
+        auto done = makePromise<void>();
+        schedule([&]() -> boost::asio::awaitable<void> {
+            co_await binding->registerDevices(devices);
+            done.promise.set_value();
+        });
+        waitFor(std::chrono::seconds{1}, done.future);
+    }
+
+    // Registers the device, then forgets requests sent for that
+    void registerDevice()
+    {
+        scan();
+        ASSERT_NE(MCTP_EID_NULL, deviceEid);
+        ASSERT_EQ(1u, binding->endpointInterface.count(deviceEid));
+        requests.clear();
+    }
+
+    mctp_eid_t deviceEid = MCTP_EID_NULL;
+    // Get Endpoint ID requests which the device does not answer
+    size_t ignoredGetEid = 0;
+    std::vector<Request> requests;
+
+    SMBusConfiguration config{};
+    std::shared_ptr<sdbusplus::asio::connection> conn;
+    std::shared_ptr<mctpd_mock::object_server_mock> bus;
+    std::shared_ptr<TestSMBusBinding> binding;
+    std::optional<DelayedResponder> responder;
+
+  private:
+    void respond(const mctp_binding_fake::mctp_frame& request)
+    {
+        auto hdr =
+            reinterpret_cast<const mctp_ctrl_msg_hdr*>(request.payload.data());
+        requests.push_back({request.header.dest, hdr->command_code});
+
+        auto prv = *reinterpret_cast<const mctp_smbus_pkt_private*>(
+            request.privateData.data());
+        auto& backdoor = binding->backdoor;
+        switch (hdr->command_code)
+        {
+            case MCTP_CTRL_CMD_GET_ENDPOINT_ID: {
+                if (ignoredGetEid > 0)
+                {
+                    ignoredGetEid--;
+                    break;
+                }
+                auto response =
+                    backdoor.prepareCtrlResponse<mctp_ctrl_resp_get_eid>(
+                        request, prv);
+                response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+                response.payload->eid = deviceEid;
+                backdoor.rx(response);
+                break;
+            }
+            case MCTP_CTRL_CMD_SET_ENDPOINT_ID: {
+                auto setEid = reinterpret_cast<const mctp_ctrl_cmd_set_eid*>(
+                    request.payload.data());
+                deviceEid = setEid->eid;
+                auto response =
+                    backdoor.prepareCtrlResponse<mctp_ctrl_resp_set_eid>(
+                        request, prv);
+                response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+                response.payload->eid_set = setEid->eid;
+                backdoor.rx(response);
+                break;
+            }
+            case MCTP_CTRL_CMD_GET_ENDPOINT_UUID: {
+                auto response =
+                    backdoor.prepareCtrlResponse<mctp_ctrl_resp_get_uuid>(
+                        request, prv);
+                response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+                reinterpret_cast<uint8_t*>(&response.payload->uuid)[0] =
+                    deviceAddress;
+                backdoor.rx(response);
+                break;
+            }
+            case MCTP_CTRL_CMD_GET_VERSION_SUPPORT: {
+                auto response = backdoor.prepareCtrlResponse<
+                    mctp_ctrl_resp_get_mctp_ver_support>(request, prv);
+                response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+                response.payload->number_of_entries = 1;
+                const uint8_t version[] = {0xF1, 0xF3, 0xF1, 0x00};
+                std::memcpy(&response.payload->version, version,
+                            sizeof(version));
+                backdoor.rx(response);
+                break;
+            }
+            case MCTP_CTRL_CMD_GET_MESSAGE_TYPE_SUPPORT: {
+                auto response = backdoor.prepareCtrlResponse<
+                    mctp_ctrl_resp_get_msg_type_support>(
+                    request, prv, sizeof(msg_type_entry));
+                response.payload->completion_code = MCTP_CTRL_CC_SUCCESS;
+                response.payload->msg_type_count = 1;
+                // Entries follow the fixed part of the response
+                *reinterpret_cast<msg_type_entry*>(response.payload + 1) =
+                    msg_type_entry{MCTP_MESSAGE_TYPE_PLDM};
+                backdoor.rx(response);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+};
+
+TEST_F(SMBusRediscoveryTest, LiveDeviceIsSkipped)
+{
+    registerDevice();
+    const mctp_eid_t eid = deviceEid;
+
+    scan();
+
+    // Single Get EID sent to the registered EID
+    EXPECT_EQ((std::vector<Request>{{eid, MCTP_CTRL_CMD_GET_ENDPOINT_ID}}),
+              requests);
+    EXPECT_EQ(1u, binding->endpointInterface.count(eid));
+}
+
+TEST_F(SMBusRediscoveryTest, DeviceWhichLostEidIsReregistered)
+{
+    registerDevice();
+    const mctp_eid_t eid = deviceEid;
+    // Device was reset and answers with null EID
+    deviceEid = MCTP_EID_NULL;
+
+    scan();
+
+    ASSERT_LE(2u, requests.size());
+    EXPECT_EQ((Request{eid, MCTP_CTRL_CMD_GET_ENDPOINT_ID}), requests[0]);
+    EXPECT_EQ((Request{MCTP_EID_NULL, MCTP_CTRL_CMD_GET_ENDPOINT_ID}),
+              requests[1]);
+    EXPECT_NE(requests.end(),
+              std::find(requests.begin(), requests.end(),
+                        Request{MCTP_EID_NULL, MCTP_CTRL_CMD_SET_ENDPOINT_ID}));
+    // Same EID is given again to device of known UUID
+    EXPECT_EQ(eid, deviceEid);
+    EXPECT_EQ(1u, binding->endpointInterface.count(eid));
+}
+
+TEST_F(SMBusRediscoveryTest, FailedLivenessCheckFallsBackToRegistration)
+{
+    registerDevice();
+    const mctp_eid_t eid = deviceEid;
+    ignoredGetEid = 1;
+
+    scan();
+
+    // Device kept its EID, so full registration does not set it again
+    ASSERT_LE(2u, requests.size());
+    EXPECT_EQ((Request{eid, MCTP_CTRL_CMD_GET_ENDPOINT_ID}), requests[0]);
+    EXPECT_EQ((Request{MCTP_EID_NULL, MCTP_CTRL_CMD_GET_ENDPOINT_ID}),
+              requests[1]);
+    EXPECT_EQ(requests.end(),
+              std::find(requests.begin(), requests.end(),
+                        Request{MCTP_EID_NULL, MCTP_CTRL_CMD_SET_ENDPOINT_ID}));
+    EXPECT_EQ(eid, deviceEid);
+    EXPECT_EQ(1u, binding->endpointInterface.count(eid));
+}
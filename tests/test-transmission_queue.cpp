@@ -0,0 +1,475 @@
+#include "mocks/hw/mctp_binding_fake.hpp"
+#include "utils/transmission_queue.hpp"
+
+#include <algorithm>
+#include <cerrno>
+
+#include <gtest/gtest.h>
+
+class TransmissionQueueTest : public ::testing::Test
+{
+  public:
+    static constexpr mctp_eid_t ownEid = 8;
+    static constexpr size_t packetSize = 4096;
+
+    TransmissionQueueTest() : driver(packetSize, sizeof(uint8_t))
+    {
+        mctp = mctp_init();
+        if (0 > mctp_register_bus(mctp, &driver.binding, ownEid))
+        {
+            throw std::runtime_error("mctp_register_bus failed");
+        }
+        mctp_binding_set_tx_enabled(&driver.binding, true);
+    }
+
+    ~TransmissionQueueTest() override
+    {
+        mctp_destroy(mctp);
+    }
+
+    std::shared_ptr<mctpd::MctpTransmissionQueue::Message>
+        send(mctp_eid_t destEid, size_t size)
+    {
+        return queue.transmit(mctp, destEid, std::vector<uint8_t>(size, 0x01),
+                              mctpd::BindingPrivate(1, 0x00));
+    }
+
+    // Responds to the oldest transmitted message which was not answered yet
+    void respondToNext()
+    {
+        ASSERT_LT(responded, driver.log.tx.size());
+        auto frame = std::next(driver.log.tx.begin(),
+                               static_cast<std::ptrdiff_t>(responded++));
+        const uint8_t tag = frame->header.flags_seq_tag & MCTP_HDR_TAG_MASK;
+        const std::vector<uint8_t> response{0x01};
+        EXPECT_TRUE(queue.receive(frame->header.dest, tag, response));
+        ioc.poll();
+        ioc.restart();
+    }
+
+    size_t transmittedTo(mctp_eid_t destEid) const
+    {
+        return static_cast<size_t>(
+            std::count_if(driver.log.tx.begin(), driver.log.tx.end(),
+                          [destEid](const auto& frame) {
+                              return frame.header.dest == destEid;
+                          }));
+    }
+
+    boost::asio::io_context ioc;
+    mctp_binding_fake driver;
+    struct mctp* mctp = nullptr;
+    mctpd::MctpTransmissionQueue queue{ioc};
+    size_t responded = 0;
+};
+
+TEST_F(TransmissionQueueTest, EndpointsTransmitIndependentlyWithoutLimit)
+{
+    constexpr mctp_eid_t EID_A = 10;
+    constexpr mctp_eid_t EID_B = 11;
+
+    auto msgA = send(EID_A, 32);
+    auto msgB = send(EID_B, 32);
+
+    EXPECT_EQ(2u, driver.log.tx.size());
+    EXPECT_TRUE(msgA->tag);
+    EXPECT_TRUE(msgB->tag);
+}
+
+TEST_F(TransmissionQueueTest, WeightedShareOfInFlightSlot)
+{
+    constexpr mctp_eid_t EID_HEAVY = 10;
+    constexpr mctp_eid_t EID_LIGHT = 11;
+    constexpr size_t MSG_COUNT = 40;
+    constexpr size_t SERVED = 32;
+
+    queue.setWeight(EID_HEAVY, 3);
+    queue.setMaxInFlight(1);
+
+    std::vector<std::shared_ptr<mctpd::MctpTransmissionQueue::Message>>
+        messages;
+    for (size_t i = 0; i < MSG_COUNT; i++)
+    {
+        messages.emplace_back(send(EID_HEAVY, 32));
+        messages.emplace_back(send(EID_LIGHT, 32));
+    }
+    EXPECT_EQ(1u, driver.log.tx.size());
+
+    while (driver.log.tx.size() < SERVED)
+    {
+        respondToNext();
+    }
+
+    const auto statistics = queue.getStatistics();
+    const double heavyShare =
+        static_cast<double>(statistics.at(EID_HEAVY).transmittedBytes) /
+        static_cast<double>(statistics.at(EID_HEAVY).transmittedBytes +
+                            statistics.at(EID_LIGHT).transmittedBytes);
+    EXPECT_NEAR(0.75, heavyShare, 0.1);
+    EXPECT_GT(transmittedTo(EID_LIGHT), 0u);
+}
+
+TEST_F(TransmissionQueueTest, HigherPriorityClassTakesNextFreeTag)
+{
+    constexpr mctp_eid_t EID = 10;
+    constexpr uint8_t NVME = 0x04;
+    constexpr uint8_t PLDM = 0x01;
+    constexpr size_t TAG_COUNT = 8;
+
+    queue.setPriorityClasses({NVME});
+
+    std::vector<std::shared_ptr<mctpd::MctpTransmissionQueue::Message>>
+        messages;
+    for (size_t i = 0; i < TAG_COUNT + 2; i++)
+    {
+        messages.emplace_back(queue.transmit(
+            mctp, EID, {PLDM, 0x00}, mctpd::BindingPrivate(1, 0x00)));
+    }
+    auto health = queue.transmit(mctp, EID, {NVME, 0x00},
+                                 mctpd::BindingPrivate(1, 0x00));
+    EXPECT_EQ(TAG_COUNT, driver.log.tx.size());
+
+    respondToNext();
+
+    EXPECT_EQ(TAG_COUNT + 1, driver.log.tx.size());
+    EXPECT_TRUE(health->tag);
+    EXPECT_EQ(NVME, driver.log.tx.back().payload.at(0));
+}
+
+TEST_F(TransmissionQueueTest, StarvedLowerClassIsServedFirst)
+{
+    constexpr mctp_eid_t EID = 10;
+    constexpr uint8_t NVME = 0x04;
+    constexpr uint8_t PLDM = 0x01;
+    constexpr size_t TAG_COUNT = 8;
+
+    queue.setPriorityClasses({NVME});
+    queue.setStarvationTimeout(std::chrono::milliseconds{0});
+
+    std::vector<std::shared_ptr<mctpd::MctpTransmissionQueue::Message>>
+        messages;
+    for (size_t i = 0; i < TAG_COUNT + 1; i++)
+    {
+        messages.emplace_back(queue.transmit(
+            mctp, EID, {PLDM, 0x00}, mctpd::BindingPrivate(1, 0x00)));
+    }
+    auto health = queue.transmit(mctp, EID, {NVME, 0x00},
+                                 mctpd::BindingPrivate(1, 0x00));
+
+    respondToNext();
+
+    EXPECT_FALSE(health->tag);
+    EXPECT_EQ(PLDM, driver.log.tx.back().payload.at(0));
+}
+
+TEST_F(TransmissionQueueTest, OverLimitMessageIsRejected)
+{
+    constexpr mctp_eid_t EID = 10;
+    constexpr size_t TAG_COUNT = 8;
+    constexpr size_t QUEUE_LIMIT = 2;
+
+    queue.setQueueLimits(QUEUE_LIMIT, 0);
+
+    std::vector<std::shared_ptr<mctpd::MctpTransmissionQueue::Message>>
+        messages;
+    for (size_t i = 0; i < TAG_COUNT + QUEUE_LIMIT; i++)
+    {
+        messages.emplace_back(send(EID, 32));
+        ASSERT_NE(nullptr, messages.back());
+    }
+
+    EXPECT_EQ(nullptr, send(EID, 32));
+    EXPECT_EQ(QUEUE_LIMIT, queue.getStatistics().at(EID).queuedMessages);
+    EXPECT_EQ(1u, queue.getStatistics().at(EID).rejectedMessages);
+
+    respondToNext();
+    EXPECT_NE(nullptr, send(EID, 32));
+}
+
+TEST_F(TransmissionQueueTest, TransientTxFailureIsRetried)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    queue.setRetryPolicy(2, std::chrono::milliseconds{1});
+    driver.txResult = -EBUSY;
+    auto message = send(EID, 32);
+    EXPECT_FALSE(message->tag);
+    EXPECT_FALSE(message->txFailed);
+
+    driver.txResult = 0;
+    ioc.run_for(std::chrono::milliseconds{20});
+
+    EXPECT_TRUE(message->tag);
+    EXPECT_FALSE(message->txFailed);
+}
+
+TEST_F(TransmissionQueueTest, PermanentTxFailureCompletesMessage)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    driver.txResult = -EINVAL;
+    auto message = send(EID, 32);
+
+    EXPECT_FALSE(message->tag);
+    EXPECT_TRUE(message->txFailed);
+    EXPECT_EQ(1u, queue.getStatistics().at(EID).failedMessages);
+    EXPECT_EQ(0u, queue.getStatistics().at(EID).queuedMessages);
+}
+
+TEST_F(TransmissionQueueTest, TimedOutTagIsQuarantined)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    queue.setTagQuarantine(std::chrono::milliseconds{1000});
+
+    auto timedOut = send(EID, 32);
+    ASSERT_TRUE(timedOut->tag);
+    const uint8_t timedOutTag = *timedOut->tag;
+    queue.dispose(mctp, EID, timedOut);
+
+    auto next = send(EID, 32);
+    ASSERT_TRUE(next->tag);
+    EXPECT_NE(timedOutTag, *next->tag);
+
+    // Late response is consumed and must not complete the new request
+    const std::vector<uint8_t> lateResponse{0x01};
+    EXPECT_TRUE(queue.receive(EID, timedOutTag, lateResponse));
+    EXPECT_FALSE(next->response);
+    EXPECT_FALSE(queue.receive(EID, timedOutTag, lateResponse));
+}
+
+TEST_F(TransmissionQueueTest, QuarantineEndsWithoutQueuedMessages)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    auto correlator = std::make_shared<mctpd::RxCorrelator>();
+    mctpd::MctpTransmissionQueue sharedQueue{ioc, correlator};
+    sharedQueue.setTagQuarantine(std::chrono::milliseconds{5});
+    std::vector<mctp_eid_t> released;
+    correlator->addReleaseObserver(
+        [&released](mctp_eid_t eid) { released.push_back(eid); });
+
+    auto timedOut = sharedQueue.transmit(mctp, EID, {0x01, 0x02},
+                                         mctpd::BindingPrivate(1, 0x00));
+    ASSERT_TRUE(timedOut->tag);
+    sharedQueue.dispose(mctp, EID, timedOut);
+    EXPECT_TRUE(released.empty());
+
+    // Nothing is queued for the endpoint, tag is returned on time anyway
+    ioc.run_for(std::chrono::milliseconds{50});
+    EXPECT_EQ(std::vector<mctp_eid_t>{EID}, released);
+}
+
+TEST_F(TransmissionQueueTest, TagReleasedOutsideQueueResumesTransmission)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    auto correlator = std::make_shared<mctpd::RxCorrelator>();
+    mctpd::MctpTransmissionQueue sharedQueue{ioc, correlator};
+
+    // Control requests hold every tag
+    std::vector<uint8_t> ctrlTags;
+    while (auto tag = correlator->allocateTag(EID))
+    {
+        ctrlTags.push_back(*tag);
+    }
+
+    auto message = sharedQueue.transmit(mctp, EID, {0x01, 0x02},
+                                        mctpd::BindingPrivate(1, 0x00));
+    ASSERT_TRUE(message);
+    EXPECT_FALSE(message->tag);
+
+    // No polling while tags are taken
+    ioc.run_for(std::chrono::milliseconds{50});
+    ioc.restart();
+    EXPECT_EQ(0u, driver.log.tx.size());
+
+    correlator->releaseTag(EID, ctrlTags.back());
+    ioc.poll();
+    EXPECT_EQ(1u, driver.log.tx.size());
+    ASSERT_TRUE(message->tag);
+    EXPECT_EQ(ctrlTags.back(), *message->tag);
+}
+
+TEST_F(TransmissionQueueTest, PldmResponseWithOtherInstanceIdIsIgnored)
+{
+    constexpr mctp_eid_t EID = 10;
+    constexpr uint8_t PLDM = 0x01;
+
+    queue.setCorrelationHook(
+        PLDM, mctpd::MctpTransmissionQueue::matchPldmInstanceId);
+
+    auto message = queue.transmit(mctp, EID, {PLDM, 0x83, 0x02, 0x11},
+                                  mctpd::BindingPrivate(1, 0x00));
+    ASSERT_TRUE(message->tag);
+    const uint8_t tag = *message->tag;
+
+    const std::vector<uint8_t> otherResponse{PLDM, 0x02, 0x02, 0x11, 0x00};
+    EXPECT_FALSE(queue.receive(EID, tag, otherResponse));
+    EXPECT_FALSE(message->response);
+
+    const std::vector<uint8_t> response{PLDM, 0x03, 0x02, 0x11, 0x00};
+    EXPECT_TRUE(queue.receive(EID, tag, response));
+    EXPECT_TRUE(message->response);
+}
+
+TEST_F(TransmissionQueueTest, UnansweredMessageTimesOut)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    auto answered = send(EID, 32);
+    auto unanswered = send(EID, 32);
+
+    std::optional<boost::system::error_code> answeredEc;
+    std::optional<boost::system::error_code> unansweredEc;
+    queue.asyncWait(answered, std::chrono::milliseconds{1000},
+                    [&answeredEc](boost::system::error_code ec) {
+                        answeredEc = ec;
+                    });
+    queue.asyncWait(unanswered, std::chrono::milliseconds{5},
+                    [&unansweredEc](boost::system::error_code ec) {
+                        unansweredEc = ec;
+                    });
+
+    respondToNext();
+    ASSERT_TRUE(answeredEc);
+    EXPECT_FALSE(*answeredEc);
+    EXPECT_FALSE(unansweredEc);
+
+    ioc.run_for(std::chrono::milliseconds{50});
+    ASSERT_TRUE(unansweredEc);
+    EXPECT_EQ(boost::asio::error::timed_out, *unansweredEc);
+    EXPECT_FALSE(unanswered->response);
+}
+
+TEST_F(TransmissionQueueTest, AdaptiveWindowGrowsOnResponsesAndHalvesOnTimeout)
+{
+    constexpr mctp_eid_t EID = 10;
+    constexpr size_t MSG_COUNT = 8;
+
+    std::vector<uint8_t> windows;
+    queue.setAdaptiveWindow(true, 1);
+    queue.setTagQuarantine(std::chrono::milliseconds{0});
+    queue.setWindowObserver([&windows](mctp_eid_t, uint8_t window) {
+        windows.push_back(window);
+    });
+
+    std::vector<std::shared_ptr<mctpd::MctpTransmissionQueue::Message>>
+        messages;
+    for (size_t i = 0; i < MSG_COUNT; i++)
+    {
+        messages.emplace_back(send(EID, 32));
+    }
+    EXPECT_EQ(1u, driver.log.tx.size());
+
+    // 1 response opens second slot, 2 more open third one
+    respondToNext();
+    EXPECT_EQ(2, queue.getWindow(EID));
+    EXPECT_EQ(3u, driver.log.tx.size());
+    respondToNext();
+    respondToNext();
+    EXPECT_EQ(3, queue.getWindow(EID));
+    EXPECT_EQ(6u, driver.log.tx.size());
+
+    queue.dispose(mctp, EID, messages[3], true);
+    EXPECT_EQ(1, queue.getWindow(EID));
+    EXPECT_EQ(6u, driver.log.tx.size());
+    EXPECT_EQ((std::vector<uint8_t>{2, 3, 1}), windows);
+}
+
+TEST_F(TransmissionQueueTest, CancelledMessageDoesNotShrinkWindow)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    queue.setAdaptiveWindow(true, 4);
+    queue.setTagQuarantine(std::chrono::milliseconds{0});
+
+    auto cancelled = send(EID, 32);
+    ASSERT_TRUE(cancelled->tag);
+    queue.dispose(mctp, EID, cancelled);
+    EXPECT_EQ(4, queue.getWindow(EID));
+}
+
+TEST_F(TransmissionQueueTest, RoundTripTimeIsReportedForResponses)
+{
+    constexpr mctp_eid_t EID = 10;
+
+    std::vector<mctp_eid_t> sampled;
+    queue.setRttObserver(
+        [&sampled](mctp_eid_t eid, std::chrono::microseconds rtt) {
+            EXPECT_GE(rtt.count(), 0);
+            sampled.push_back(eid);
+        });
+
+    auto answered = send(EID, 32);
+    auto unanswered = send(EID, 32);
+    respondToNext();
+    queue.dispose(mctp, EID, unanswered);
+
+    EXPECT_EQ((std::vector<mctp_eid_t>{EID}), sampled);
+}
+
+TEST_F(TransmissionQueueTest, EarliestDeadlineIsTransmittedFirst)
+{
+    constexpr mctp_eid_t EID = 10;
+    constexpr size_t TAG_COUNT = 8;
+    const auto now = std::chrono::steady_clock::now();
+
+    std::vector<std::shared_ptr<mctpd::MctpTransmissionQueue::Message>>
+        messages;
+    for (size_t i = 0; i < TAG_COUNT; i++)
+    {
+        messages.emplace_back(send(EID, 32));
+    }
+    auto noDeadline = send(EID, 32);
+    auto late = queue.transmit(mctp, EID, std::vector<uint8_t>(32, 0x01),
+                               mctpd::BindingPrivate(1, 0x00),
+                               now + std::chrono::seconds{1000});
+    auto early = queue.transmit(mctp, EID, std::vector<uint8_t>(32, 0x01),
+                                mctpd::BindingPrivate(1, 0x00),
+                                now + std::chrono::seconds{10});
+
+    respondToNext();
+    EXPECT_TRUE(early->tag);
+    EXPECT_FALSE(late->tag);
+    respondToNext();
+    EXPECT_TRUE(late->tag);
+    EXPECT_FALSE(noDeadline->tag);
+    respondToNext();
+    EXPECT_TRUE(noDeadline->tag);
+}
+
+TEST_F(TransmissionQueueTest, ExpiredMessageIsShedBeforeTransmission)
+{
+    constexpr mctp_eid_t EID = 10;
+    constexpr size_t TAG_COUNT = 8;
+
+    std::vector<std::shared_ptr<mctpd::MctpTransmissionQueue::Message>>
+        messages;
+    for (size_t i = 0; i < TAG_COUNT; i++)
+    {
+        messages.emplace_back(send(EID, 32));
+    }
+    auto expired = queue.transmit(mctp, EID, std::vector<uint8_t>(32, 0x01),
+                                  mctpd::BindingPrivate(1, 0x00),
+                                  std::chrono::steady_clock::now());
+    auto pending = send(EID, 32);
+
+    std::optional<boost::system::error_code> expiredEc;
+    queue.asyncWait(expired, std::chrono::milliseconds{1000},
+                    [&expiredEc](boost::system::error_code ec) {
+                        expiredEc = ec;
+                    });
+
+    respondToNext();
+    EXPECT_EQ(TAG_COUNT + 1, driver.log.tx.size());
+    EXPECT_TRUE(pending->tag);
+    EXPECT_TRUE(expired->shed);
+    EXPECT_FALSE(expired->tag);
+    ASSERT_TRUE(expiredEc);
+    EXPECT_EQ(boost::asio::error::timed_out, *expiredEc);
+
+    const auto statistics = queue.getStatistics().at(EID);
+    EXPECT_EQ(1u, statistics.shedMessages);
+    EXPECT_EQ(0u, statistics.queuedMessages);
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/post.hpp>
 #include <boost/asio/spawn.hpp>
@@ -42,10 +45,21 @@ struct AsyncTestBase
         boost::asio::spawn(ioc, func);
     }
 
+    // Specialization for C++20 coroutines
+    template <typename Functor>
+    std::enable_if_t<std::is_same<std::invoke_result_t<Functor>,
+                                  boost::asio::awaitable<void>>::value>
+        schedule(Functor&& func)
+    {
+        boost::asio::co_spawn(ioc, func, boost::asio::detached);
+    }
+
     // Specialization for 'normal' invocables
     template <typename Functor>
     std::enable_if_t<
-        !std::is_invocable<Functor, boost::asio::yield_context>::value>
+        !std::is_invocable<Functor, boost::asio::yield_context>::value &&
+        !std::is_same<std::invoke_result_t<Functor>,
+                      boost::asio::awaitable<void>>::value>
         schedule(Functor&& func)
     {
         boost::asio::post(ioc, func);
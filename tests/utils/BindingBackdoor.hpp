@@ -92,7 +92,10 @@ class BindingBackdoor
         hdr->dest = request.header.src;
         hdr->src = request.header.dest;
         hdr->ver = request.header.ver;
-        hdr->flags_seq_tag = (MCTP_HDR_FLAG_SOM | MCTP_HDR_FLAG_EOM);
+        // Response carries message tag of the request, with TO bit cleared
+        hdr->flags_seq_tag = static_cast<uint8_t>(
+            MCTP_HDR_FLAG_SOM | MCTP_HDR_FLAG_EOM |
+            (request.header.flags_seq_tag & MCTP_HDR_TAG_MASK));
 
         memset(mctp_pktbuf_data(pkt), 0, sizeof(Payload) + padding);
 
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "mocks/hw/mctp_binding_fake.hpp"
+
+#include "libmctp-cmds.h"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+/*
+ * Takes over transmit of the fake driver, so that every control request is
+ * answered by respond after latency, while other requests are in flight.
+ * Other packets are dropped.
+ */
+class DelayedResponder
+{
+  public:
+    using Respond = std::function<void(const mctp_binding_fake::mctp_frame&)>;
+
+    DelayedResponder(boost::asio::io_context& ioc, mctp_binding_fake& driver,
+                     std::chrono::microseconds latency, Respond&& respond) :
+        io(ioc),
+        responseLatency(latency), respondTo(std::move(respond))
+    {
+        driver.txHandler = [this, active = active](mctp_binding* binding,
+                                                   mctp_pktbuf* pkt) {
+            // Binding can still send once its responder is gone
+            return *active ? transmit(binding, pkt) : 0;
+        };
+    }
+
+    ~DelayedResponder()
+    {
+        *active = false;
+    }
+
+    DelayedResponder(const DelayedResponder&) = delete;
+    DelayedResponder& operator=(const DelayedResponder&) = delete;
+
+    size_t ctrlRequests = 0;
+
+  private:
+    boost::asio::io_context& io;
+    std::chrono::microseconds responseLatency;
+    Respond respondTo;
+    // Shared with handlers, which may outlive the responder
+    std::shared_ptr<bool> active = std::make_shared<bool>(true);
+
+    int transmit(mctp_binding* binding, mctp_pktbuf* pkt)
+    {
+        auto request = mctp_binding_fake::toMctpFrame(binding, pkt);
+        if (request.payload.size() < sizeof(mctp_ctrl_msg_hdr))
+        {
+            return 0;
+        }
+        auto hdr =
+            reinterpret_cast<const mctp_ctrl_msg_hdr*>(request.payload.data());
+        if (hdr->ic_msg_type != MCTP_CTRL_HDR_MSG_TYPE ||
+            (hdr->rq_dgram_inst & MCTP_CTRL_HDR_FLAG_REQUEST) == 0)
+        {
+            return 0;
+        }
+
+        ctrlRequests++;
+        auto timer =
+            std::make_shared<boost::asio::steady_timer>(io, responseLatency);
+        timer->async_wait([this, active = active, timer,
+                           request = std::move(request)](
+                              boost::system::error_code) {
+            if (*active)
+            {
+                respondTo(request);
+            }
+        });
+        return 0;
+    }
+};